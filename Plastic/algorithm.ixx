@@ -37,10 +37,48 @@ namespace plastic {
         }
     }
 
+    // containers whose iterators provide a hidden friend segments(first, last), returning a range of
+    // std::span covering [first, last), get their algorithms run on plain pointers segment by segment
+
+    template <class It>
+    concept has_segments = requires(const It& first, const It& last) {
+        { segments(first, last) } -> std::ranges::forward_range;
+    };
+
+    template <class It>
+    concept segmented_iterator = std::random_access_iterator<It> && (has_segments<It> || requires(const It& iter) {
+        requires std::same_as<It, std::basic_const_iterator<std::remove_cvref_t<decltype(iter.base())>>>;
+        requires has_segments<std::remove_cvref_t<decltype(iter.base())>>;
+    });
+
+    template <segmented_iterator It>
+    static auto segments_of(const It& first, const It& last) {
+        if constexpr (has_segments<It>) {
+            return segments(first, last);
+        }
+        else {
+            return segments(first.base(), last.base()) | std::views::transform([](auto segment) {
+                return std::span<const typename decltype(segment)::element_type>{ segment };
+            });
+        }
+    }
+
 #pragma region non-modifying sequence operations
 
     template <satisfy_type Sat, std::input_iterator It, std::sentinel_for<It> Se, class TPr, class Pj>
     static It find_impl(It first, Se last, const TPr& value_or_pred, Pj proj) {
+        if constexpr (segmented_iterator<It> && std::same_as<It, Se>) {
+            for (auto segment : plastic::segments_of(first, last)) {
+                auto segment_end{ segment.data() + segment.size() };
+                auto i{ plastic::find_impl<Sat>(segment.data(), segment_end, value_or_pred, proj) };
+                if (i != segment_end) {
+                    return first + (i - segment.data());
+                }
+                first += segment.size();
+            }
+            return first;
+        }
+
         while (first != last) {
             if (plastic::satisfy<Sat>(std::invoke(proj, *first), value_or_pred)) {
                 break;
@@ -142,6 +180,15 @@ namespace plastic {
 
     export template <std::input_iterator It, std::sentinel_for<It> Se, class Pj = std::identity, std::indirectly_unary_invocable<std::projected<It, Pj>> Fn>
     std::ranges::in_fun_result<It, Fn> for_each(It first, Se last, Fn func, Pj proj = {}) {
+        if constexpr (segmented_iterator<It> && std::same_as<It, Se>) {
+            for (auto segment : plastic::segments_of(first, last)) {
+                for (auto& element : segment) {
+                    std::invoke(func, std::invoke(proj, element));
+                }
+            }
+            return { std::move(last), std::move(func) };
+        }
+
         while (first != last) {
             std::invoke(func, std::invoke(proj, *first));
             ++first;
@@ -529,6 +576,20 @@ namespace plastic {
     export template <std::input_iterator It, std::sentinel_for<It> Se, std::weakly_incrementable Out>
         requires std::indirectly_copyable<It, Out>
     std::ranges::in_out_result<It, Out> copy(It first, Se last, Out output) {
+        if constexpr (segmented_iterator<It> && std::same_as<It, Se>) {
+            for (auto segment : plastic::segments_of(first, last)) {
+                output = plastic::copy(segment.data(), segment.data() + segment.size(), std::move(output)).out;
+            }
+            return { std::move(last), std::move(output) };
+        }
+        else if constexpr (segmented_iterator<Out> && std::contiguous_iterator<It> && std::sized_sentinel_for<Se, It>) {
+            auto count{ last - first };
+            for (auto segment : plastic::segments_of(output, output + count)) {
+                first = plastic::copy(first, first + segment.size(), segment.data()).in;
+            }
+            return { std::move(first), output + count };
+        }
+
         while (first != last) {
             *output++ = *first;
             ++first;
@@ -674,6 +735,13 @@ namespace plastic {
     export template <class Out, std::sentinel_for<Out> Se, class T = std::iter_value_t<Out>>
         requires std::output_iterator<Out, const T&>
     Out fill(Out first, Se last, const T& value) {
+        if constexpr (segmented_iterator<Out> && std::same_as<Out, Se>) {
+            for (auto segment : plastic::segments_of(first, last)) {
+                plastic::fill(segment.data(), segment.data() + segment.size(), value);
+            }
+            return last;
+        }
+
         while (first != last) {
             *first++ = value;
         }
@@ -1350,6 +1418,36 @@ namespace plastic {
         requires std::sortable<It, Pr, Pj>
     It sort(It first, Se last, Pr pred = {}, Pj proj = {}) {
         It last_iter{ std::ranges::next(first, last) };
+        if constexpr (segmented_iterator<It>) {
+            if (first != last_iter) {
+                auto segments{ plastic::segments_of(first, last_iter) };
+                auto segment{ *std::ranges::begin(segments) };
+                if (std::cmp_equal(segment.size(), last_iter - first)) {
+                    plastic::intro_sort(segment.data(), segment.data() + segment.size(), last_iter - first, pred, proj);
+                    return last_iter;
+                }
+
+                // several segments are sorted together in a buffer, the elements moving there and back segment by
+                // segment
+                std::allocator<std::iter_value_t<It>> alloc;
+                auto size{ static_cast<std::size_t>(last_iter - first) };
+                auto buf{ alloc.allocate(size) }, k{ buf };
+                for (auto part : segments) {
+                    for (auto& element : part) {
+                        std::ranges::construct_at(k++, std::move(element));
+                    }
+                }
+                plastic::intro_sort(buf, k, last_iter - first, pred, proj);
+                k = buf;
+                for (auto part : segments) {
+                    k = plastic::move(k, k + part.size(), part.data()).in;
+                }
+                std::ranges::destroy(buf, k);
+                alloc.deallocate(buf, size);
+                return last_iter;
+            }
+        }
+
         plastic::intro_sort(first, last_iter, last_iter - first, pred, proj);
         return last_iter;
     }
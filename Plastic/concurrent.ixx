@@ -0,0 +1,875 @@
+module;
+
+#include <cassert>
+
+export module plastic.concurrent;
+
+import std;
+import plastic.memory;
+
+namespace plastic {
+
+    constexpr std::size_t cache_line_size{ std::hardware_destructive_interference_size };
+
+    // bounded wait-free queue for exactly one producer thread and one consumer thread
+    export template <class T, class Alloc = std::allocator<T>>
+    class SpscRing {
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using size_type = std::size_t;
+
+    private:
+        Storage<value_type, allocator_type> _data;
+        size_type _mask;
+
+        // indices only grow and are masked on access, each side caches the other one to avoid contention
+        alignas(cache_line_size) std::atomic<size_type> _tail{};
+        size_type _cached_head{};
+        alignas(cache_line_size) std::atomic<size_type> _head{};
+        size_type _cached_tail{};
+
+        value_type* _slot(size_type index) {
+            return _data.begin() + (index & _mask);
+        }
+
+    public:
+        explicit SpscRing(size_type capacity, const allocator_type& alloc = allocator_type()) :
+            _data{ std::bit_ceil(capacity), alloc },
+            _mask{ _data.size() - 1 } {
+
+            assert(capacity != 0);
+        }
+
+        SpscRing(const SpscRing&) = delete;
+
+        ~SpscRing() {
+            for (size_type i{ _head.load(std::memory_order::relaxed) }, tail{ _tail.load(std::memory_order::relaxed) }; i != tail; ++i) {
+                std::ranges::destroy_at(_slot(i));
+            }
+        }
+
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        allocator_type get_allocator() const {
+            return _data.get_allocator();
+        }
+
+        // approximate while the other side is running
+        bool empty() const {
+            return size() == 0;
+        }
+
+        size_type size() const {
+            return _tail.load(std::memory_order::acquire) - _head.load(std::memory_order::acquire);
+        }
+
+        size_type capacity() const {
+            return _data.size();
+        }
+
+        template <class... Args>
+        bool try_emplace(Args&&... args) {
+            size_type tail{ _tail.load(std::memory_order::relaxed) };
+            if (tail - _cached_head == capacity()) {
+                _cached_head = _head.load(std::memory_order::acquire);
+                if (tail - _cached_head == capacity()) {
+                    return false;
+                }
+            }
+
+            std::ranges::construct_at(_slot(tail), std::forward<Args>(args)...);
+            _tail.store(tail + 1, std::memory_order::release);
+            return true;
+        }
+
+        bool try_push(const value_type& value) {
+            return try_emplace(value);
+        }
+
+        bool try_push(value_type&& value) {
+            return try_emplace(std::move(value));
+        }
+
+        // pushes as many of the count elements as fit, publishing them at once
+        template <std::input_iterator It>
+        size_type try_push_n(It first, size_type count) {
+            size_type tail{ _tail.load(std::memory_order::relaxed) };
+            if (capacity() - (tail - _cached_head) < count) {
+                _cached_head = _head.load(std::memory_order::acquire);
+            }
+
+            count = std::ranges::min(count, capacity() - (tail - _cached_head));
+            for (size_type i{}; i != count; ++i, ++first) {
+                std::ranges::construct_at(_slot(tail + i), *first);
+            }
+            _tail.store(tail + count, std::memory_order::release);
+            return count;
+        }
+
+        std::optional<value_type> try_pop() {
+            size_type head{ _head.load(std::memory_order::relaxed) };
+            if (head == _cached_tail) {
+                _cached_tail = _tail.load(std::memory_order::acquire);
+                if (head == _cached_tail) {
+                    return std::nullopt;
+                }
+            }
+
+            value_type* slot{ _slot(head) };
+            std::optional<value_type> value{ std::move(*slot) };
+            std::ranges::destroy_at(slot);
+            _head.store(head + 1, std::memory_order::release);
+            return value;
+        }
+
+        // moves up to count elements to out, releasing their slots at once
+        template <std::weakly_incrementable Out>
+        size_type try_pop_n(Out out, size_type count) {
+            size_type head{ _head.load(std::memory_order::relaxed) };
+            if (_cached_tail - head < count) {
+                _cached_tail = _tail.load(std::memory_order::acquire);
+            }
+
+            count = std::ranges::min(count, _cached_tail - head);
+            for (size_type i{}; i != count; ++i, ++out) {
+                value_type* slot{ _slot(head + i) };
+                *out = std::move(*slot);
+                std::ranges::destroy_at(slot);
+            }
+            _head.store(head + count, std::memory_order::release);
+            return count;
+        }
+    };
+
+    // bounded lock-free queue for any number of producers and consumers, every cell carries a sequence number
+    // telling which lap of the ring may use it next; a claimed cell must be filled, so values move in and out
+    // without throwing and are built before claiming when that may throw
+    export template <class T, class Alloc = std::allocator<T>>
+        requires std::is_nothrow_move_constructible_v<T>
+    class MpmcRing {
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using size_type = std::size_t;
+
+    private:
+        struct Cell {
+            std::atomic<size_type> sequence;
+
+            union {
+                value_type value;
+            };
+
+            Cell(size_type sequence) :
+                sequence{ sequence } {}
+
+            ~Cell() {}
+        };
+
+        using CellAlloc = std::allocator_traits<allocator_type>::template rebind_alloc<Cell>;
+
+        Storage<Cell, CellAlloc> _cells;
+        size_type _mask;
+
+        alignas(cache_line_size) std::atomic<size_type> _tail{};
+        alignas(cache_line_size) std::atomic<size_type> _head{};
+
+        // claims count consecutive cells whose sequence is offset past their index, returns the first index
+        size_type _claim(std::atomic<size_type>& index, size_type& count, size_type offset) {
+            size_type pos{ index.load(std::memory_order::relaxed) };
+            while (true) {
+                size_type ready{};
+                while (ready != count && _cells.begin()[(pos + ready) & _mask].sequence.load(std::memory_order::acquire) == pos + ready + offset) {
+                    ++ready;
+                }
+
+                if (ready == 0) {
+                    size_type sequence{ _cells.begin()[pos & _mask].sequence.load(std::memory_order::acquire) };
+                    if (static_cast<std::ptrdiff_t>(sequence - (pos + offset)) < 0) {
+                        count = 0;
+                        return pos;
+                    }
+                    pos = index.load(std::memory_order::relaxed);
+                }
+                else if (index.compare_exchange_weak(pos, pos + ready, std::memory_order::relaxed)) {
+                    count = ready;
+                    return pos;
+                }
+            }
+        }
+
+    public:
+        explicit MpmcRing(size_type capacity, const allocator_type& alloc = allocator_type()) :
+            _cells{ std::bit_ceil(capacity), CellAlloc(alloc) },
+            _mask{ _cells.size() - 1 } {
+
+            assert(capacity != 0);
+            for (size_type i{}; i != _cells.size(); ++i) {
+                std::ranges::construct_at(_cells.begin() + i, i);
+            }
+        }
+
+        MpmcRing(const MpmcRing&) = delete;
+
+        ~MpmcRing() {
+            for (size_type i{ _head.load(std::memory_order::relaxed) }, tail{ _tail.load(std::memory_order::relaxed) }; i != tail; ++i) {
+                std::ranges::destroy_at(std::addressof(_cells.begin()[i & _mask].value));
+            }
+            std::ranges::destroy(_cells);
+        }
+
+        MpmcRing& operator=(const MpmcRing&) = delete;
+
+        allocator_type get_allocator() const {
+            return allocator_type(_cells.get_allocator());
+        }
+
+        // approximate while other threads are running
+        bool empty() const {
+            return size() == 0;
+        }
+
+        size_type size() const {
+            size_type head{ _head.load(std::memory_order::acquire) }, tail{ _tail.load(std::memory_order::acquire) };
+            return tail > head ? tail - head : 0;
+        }
+
+        size_type capacity() const {
+            return _cells.size();
+        }
+
+        // a value that may throw is built first and dropped again when the ring is full
+        template <class... Args>
+        bool try_emplace(Args&&... args) {
+            if constexpr (!std::is_nothrow_constructible_v<value_type, Args...>) {
+                return try_emplace(value_type(std::forward<Args>(args)...));
+            }
+
+            size_type count{ 1 }, pos{ _claim(_tail, count, 0) };
+            if (count == 0) {
+                return false;
+            }
+
+            Cell& cell{ _cells.begin()[pos & _mask] };
+            std::ranges::construct_at(std::addressof(cell.value), std::forward<Args>(args)...);
+            cell.sequence.store(pos + 1, std::memory_order::release);
+            return true;
+        }
+
+        bool try_push(const value_type& value) {
+            return try_emplace(value);
+        }
+
+        bool try_push(value_type&& value) {
+            return try_emplace(std::move(value));
+        }
+
+        // values that may throw while being built are pushed one by one, like with try_emplace
+        template <std::input_iterator It>
+        size_type try_push_n(It first, size_type count) {
+            if constexpr (!std::is_nothrow_constructible_v<value_type, std::iter_reference_t<It>>) {
+                size_type pushed{};
+                while (pushed != count && try_emplace(*first)) {
+                    ++pushed;
+                    ++first;
+                }
+                return pushed;
+            }
+
+            if (count == 0) {
+                return 0;
+            }
+
+            size_type pos{ _claim(_tail, count, 0) };
+            for (size_type i{}; i != count; ++i, ++first) {
+                Cell& cell{ _cells.begin()[(pos + i) & _mask] };
+                std::ranges::construct_at(std::addressof(cell.value), *first);
+                cell.sequence.store(pos + i + 1, std::memory_order::release);
+            }
+            return count;
+        }
+
+        std::optional<value_type> try_pop() {
+            size_type count{ 1 }, pos{ _claim(_head, count, 1) };
+            if (count == 0) {
+                return std::nullopt;
+            }
+
+            Cell& cell{ _cells.begin()[pos & _mask] };
+            std::optional<value_type> value{ std::move(cell.value) };
+            std::ranges::destroy_at(std::addressof(cell.value));
+            cell.sequence.store(pos + capacity(), std::memory_order::release);
+            return value;
+        }
+
+        template <std::weakly_incrementable Out>
+        size_type try_pop_n(Out out, size_type count) {
+            if (count == 0) {
+                return 0;
+            }
+
+            size_type pos{ _claim(_head, count, 1) };
+            for (size_type i{}; i != count; ++i, ++out) {
+                Cell& cell{ _cells.begin()[(pos + i) & _mask] };
+                *out = std::move(cell.value);
+                std::ranges::destroy_at(std::addressof(cell.value));
+                cell.sequence.store(pos + i + capacity(), std::memory_order::release);
+            }
+            return count;
+        }
+    };
+
+    // append-only vector for many producer threads, elements live in segments that double in size and never move
+    // an index is claimed before its element is constructed, size() only counts the prefix whose elements are all
+    // constructed, so reads below size() are safe while other threads keep appending; an element whose construction
+    // throws would stop size() for good, so afterwards broken() holds and appends throw until the vector is cleared
+    export template <class T, class Alloc = std::allocator<T>>
+    class ConcurrentVector {
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+    private:
+        using FlagAlloc = std::allocator_traits<allocator_type>::template rebind_alloc<std::atomic<bool>>;
+
+        struct Segment {
+            Storage<value_type, allocator_type> values;
+            Storage<std::atomic<bool>, FlagAlloc> ready;
+
+            Segment(size_type size, const allocator_type& alloc) :
+                values{ size, alloc },
+                ready{ size, FlagAlloc(alloc) } {
+
+                for (std::atomic<bool>& i : ready) {
+                    std::ranges::construct_at(std::addressof(i), false);
+                }
+            }
+        };
+
+        using SegmentAlloc = std::allocator_traits<allocator_type>::template rebind_alloc<Segment>;
+        using SegmentTraits = std::allocator_traits<SegmentAlloc>;
+
+        static constexpr size_type _first_size{ 8 };
+        static constexpr size_type _max_segments{ std::numeric_limits<size_type>::digits - std::countr_zero(_first_size) };
+
+        static size_type _segment_of(size_type index) {
+            return std::bit_width(index / _first_size + 1) - 1;
+        }
+
+        static size_type _segment_start(size_type segment) {
+            return _first_size * ((size_type{ 1 } << segment) - 1);
+        }
+
+        static size_type _segment_size(size_type segment) {
+            return _first_size << segment;
+        }
+
+    public:
+        class iterator {
+            friend ConcurrentVector;
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = value_type*;
+            using reference = value_type&;
+
+        private:
+            ConcurrentVector* _cont{};
+            size_type _index{};
+
+            iterator(ConcurrentVector* cont, size_type index) :
+                _cont{ cont },
+                _index{ index } {}
+
+            auto _segments(iterator last) const {
+                size_type first_segment{ _segment_of(_index) };
+                size_type last_segment{ _index == last._index ? first_segment : _segment_of(last._index - 1) + 1 };
+                return std::views::iota(first_segment, last_segment) | std::views::transform([first{ *this }, last](size_type segment) {
+                    size_type start{ _segment_start(segment) };
+                    pointer values{ first._cont->_table[segment].load(std::memory_order::acquire)->values.begin() };
+                    return std::span{ values + (std::ranges::max(first._index, start) - start), values + (std::ranges::min(last._index, start + _segment_size(segment)) - start) };
+                });
+            }
+
+        public:
+            iterator() = default;
+
+            reference operator*() const {
+                return *_cont->_find(_index);
+            }
+
+            pointer operator->() const {
+                return _cont->_find(_index);
+            }
+
+            reference operator[](difference_type index) const {
+                return *(*this + index);
+            }
+
+            friend bool operator==(iterator left, iterator right) {
+                return left._index == right._index;
+            }
+
+            friend auto operator<=>(iterator left, iterator right) {
+                return left._index <=> right._index;
+            }
+
+            iterator& operator+=(difference_type diff) {
+                _index += diff;
+                return *this;
+            }
+
+            iterator& operator-=(difference_type diff) {
+                _index -= diff;
+                return *this;
+            }
+
+            friend iterator operator+(iterator iter, difference_type diff) {
+                return iter += diff;
+            }
+
+            friend iterator operator+(difference_type diff, iterator iter) {
+                return iter += diff;
+            }
+
+            friend iterator operator-(iterator iter, difference_type diff) {
+                return iter -= diff;
+            }
+
+            friend difference_type operator-(iterator left, iterator right) {
+                return static_cast<difference_type>(left._index - right._index);
+            }
+
+            friend auto segments(iterator first, iterator last) {
+                return first._segments(last);
+            }
+
+            iterator& operator++() {
+                ++_index;
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator temp{ *this };
+                ++*this;
+                return temp;
+            }
+
+            iterator& operator--() {
+                --_index;
+                return *this;
+            }
+
+            iterator operator--(int) {
+                iterator temp{ *this };
+                --*this;
+                return temp;
+            }
+        };
+
+        using const_iterator = std::const_iterator<iterator>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    private:
+#ifdef _MSC_VER
+        [[msvc::no_unique_address]]
+#else
+        [[no_unique_address]]
+#endif
+        SegmentAlloc _alloc;
+        std::array<std::atomic<Segment*>, _max_segments> _table{};
+        alignas(cache_line_size) std::atomic<size_type> _claimed{};
+        alignas(cache_line_size) std::atomic<size_type> _size{};
+        std::atomic<bool> _broken{};
+
+        void _check_intact() const {
+            if (_broken.load()) {
+                throw std::runtime_error{ "an append to the ConcurrentVector failed" };
+            }
+        }
+
+        pointer _find(size_type index) const {
+            size_type segment{ _segment_of(index) };
+            return _table[segment].load(std::memory_order::acquire)->values.begin() + (index - _segment_start(segment));
+        }
+
+        // the claimer of its first index allocates a segment, other appenders wait for it, unless an append failed
+        // before it got there; only reserve() races with the claimer, the loser freeing its copy
+        Segment* _wait_segment(size_type segment) const {
+            Segment* current;
+            while ((current = _table[segment].load(std::memory_order::acquire)) == nullptr) {
+                _check_intact();
+                std::this_thread::yield();
+            }
+            return current;
+        }
+
+        Segment* _segment(size_type segment) {
+            Segment* current{ _table[segment].load(std::memory_order::acquire) };
+            if (current != nullptr) {
+                return current;
+            }
+
+            Segment* created{ SegmentTraits::allocate(_alloc, 1) };
+            try {
+                SegmentTraits::construct(_alloc, created, _segment_size(segment), get_allocator());
+            }
+            catch (...) {
+                SegmentTraits::deallocate(_alloc, created, 1);
+                throw;
+            }
+
+            if (!_table[segment].compare_exchange_strong(current, created, std::memory_order::acq_rel, std::memory_order::acquire)) {
+                SegmentTraits::destroy(_alloc, created);
+                SegmentTraits::deallocate(_alloc, created, 1);
+                return current;
+            }
+            return created;
+        }
+
+        template <class... Args>
+        pointer _construct(size_type index, Args&&... args) {
+            size_type segment_index{ _segment_of(index) }, offset{ index - _segment_start(segment_index) };
+            try {
+                Segment* segment{ offset == 0 ? _segment(segment_index) : _wait_segment(segment_index) };
+                pointer ptr{ std::ranges::construct_at(segment->values.begin() + offset, std::forward<Args>(args)...) };
+                segment->ready.begin()[offset].store(true);
+                return ptr;
+            }
+            catch (...) {
+                _broken.store(true);
+                throw;
+            }
+        }
+
+        bool _is_ready(size_type index) const {
+            size_type segment_index{ _segment_of(index) };
+            Segment* segment{ _table[segment_index].load(std::memory_order::acquire) };
+            return segment != nullptr && segment->ready.begin()[index - _segment_start(segment_index)].load();
+        }
+
+        // every appender helps to move size() over the elements that are ready, whoever readies the element
+        // the size stopped at sees it, so no thread waits for another
+        void _publish() {
+            size_type size{ _size.load() };
+            while (size != _claimed.load() && _is_ready(size)) {
+                if (_size.compare_exchange_weak(size, size + 1)) {
+                    ++size;
+                }
+            }
+        }
+
+        template <class... Args>
+        iterator _grow_by(size_type count, const Args&... args) {
+            _check_intact();
+            size_type first{ _claimed.fetch_add(count) };
+            assert(first + count <= max_size());
+            for (size_type i{}; i != count; ++i) {
+                _construct(first + i, args...);
+            }
+            _publish();
+            return { this, first };
+        }
+
+    public:
+        ConcurrentVector() = default;
+
+        explicit ConcurrentVector(const allocator_type& alloc) :
+            _alloc{ alloc } {}
+
+        explicit ConcurrentVector(size_type size, const allocator_type& alloc = allocator_type()) :
+            _alloc{ alloc } {
+
+            grow_by(size);
+        }
+
+        ConcurrentVector(size_type size, const_reference value, const allocator_type& alloc = allocator_type()) :
+            _alloc{ alloc } {
+
+            grow_by(size, value);
+        }
+
+        template <std::forward_iterator It>
+        ConcurrentVector(It first, It last, const allocator_type& alloc = allocator_type()) :
+            _alloc{ alloc } {
+
+            grow_by(first, last);
+        }
+
+        ConcurrentVector(const ConcurrentVector& other) :
+            ConcurrentVector(other, std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator())) {}
+
+        ConcurrentVector(const ConcurrentVector& other, const allocator_type& alloc) :
+            ConcurrentVector(other.begin(), other.end(), alloc) {}
+
+        ConcurrentVector(ConcurrentVector&& other) noexcept :
+            _alloc{ other._alloc } {
+
+            this->swap(other);
+        }
+
+        ConcurrentVector(std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type()) :
+            ConcurrentVector(list.begin(), list.end(), alloc) {}
+
+        ~ConcurrentVector() {
+            clear();
+            for (std::atomic<Segment*>& i : _table) {
+                if (Segment* segment{ i.load(std::memory_order::relaxed) }) {
+                    SegmentTraits::destroy(_alloc, segment);
+                    SegmentTraits::deallocate(_alloc, segment, 1);
+                }
+            }
+        }
+
+        ConcurrentVector& operator=(const ConcurrentVector& other) {
+            ConcurrentVector temp(other, get_allocator());
+            this->swap(temp);
+            return *this;
+        }
+
+        ConcurrentVector& operator=(ConcurrentVector&& other) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value) {
+            if (get_allocator() == other.get_allocator()) {
+                this->swap(other);
+            }
+            else {
+                ConcurrentVector temp(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()), get_allocator());
+                this->swap(temp);
+            }
+            return *this;
+        }
+
+        ConcurrentVector& operator=(std::initializer_list<value_type> list) {
+            ConcurrentVector temp(list, get_allocator());
+            this->swap(temp);
+            return *this;
+        }
+
+        allocator_type get_allocator() const {
+            return allocator_type(_alloc);
+        }
+
+        iterator begin() {
+            return { this, 0 };
+        }
+
+        const_iterator begin() const {
+            return const_cast<ConcurrentVector&>(*this).begin();
+        }
+
+        iterator end() {
+            return { this, size() };
+        }
+
+        const_iterator end() const {
+            return const_cast<ConcurrentVector&>(*this).end();
+        }
+
+        reverse_iterator rbegin() {
+            return reverse_iterator{ end() };
+        }
+
+        const_reverse_iterator rbegin() const {
+            return const_reverse_iterator{ end() };
+        }
+
+        reverse_iterator rend() {
+            return reverse_iterator{ begin() };
+        }
+
+        const_reverse_iterator rend() const {
+            return const_reverse_iterator{ begin() };
+        }
+
+        const_iterator cbegin() const {
+            return begin();
+        }
+
+        const_iterator cend() const {
+            return end();
+        }
+
+        const_reverse_iterator crbegin() const {
+            return rbegin();
+        }
+
+        const_reverse_iterator crend() const {
+            return rend();
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        size_type size() const {
+            return _size.load(std::memory_order::acquire);
+        }
+
+        size_type max_size() const {
+            return _segment_start(_max_segments);
+        }
+
+        // whether an append failed, which then stopped size() until the vector is cleared
+        bool broken() const {
+            return _broken.load();
+        }
+
+        size_type capacity() const {
+            size_type capacity{};
+            for (size_type i{}; i != _max_segments; ++i) {
+                if (_table[i].load(std::memory_order::acquire) != nullptr) {
+                    capacity += _segment_size(i);
+                }
+            }
+            return capacity;
+        }
+
+        void reserve(size_type new_capacity) {
+            for (size_type i{}; i != _max_segments && _segment_start(i) < new_capacity; ++i) {
+                _segment(i);
+            }
+        }
+
+        MemoryStats memory_stats() const {
+            size_type size{ _size.load(std::memory_order::acquire) };
+            MemoryStats stats{ .elements = size, .bytes_used = size * sizeof(value_type) };
+            for (size_type i{}; i != _max_segments; ++i) {
+                if (_table[i].load(std::memory_order::acquire) != nullptr) {
+                    stats.allocations += 3;
+                    stats.bytes_allocated += sizeof(Segment) + _segment_size(i) * (sizeof(value_type) + sizeof(std::atomic<bool>));
+                }
+            }
+            return stats;
+        }
+
+        reference operator[](size_type index) {
+            assert(index < size());
+            return *_find(index);
+        }
+
+        const_reference operator[](size_type index) const {
+            assert(index < size());
+            return *_find(index);
+        }
+
+        reference front() {
+            assert(!empty());
+            return *_find(0);
+        }
+
+        const_reference front() const {
+            assert(!empty());
+            return *_find(0);
+        }
+
+        reference back() {
+            assert(!empty());
+            return *_find(size() - 1);
+        }
+
+        const_reference back() const {
+            assert(!empty());
+            return *_find(size() - 1);
+        }
+
+        // the returned reference stays valid until the vector is cleared or destroyed
+        template <class... Args>
+        reference emplace_back(Args&&... args) {
+            _check_intact();
+            size_type index{ _claimed.fetch_add(1) };
+            assert(index < max_size());
+            pointer ptr{ _construct(index, std::forward<Args>(args)...) };
+            _publish();
+            return *ptr;
+        }
+
+        reference push_back(const_reference value) {
+            return emplace_back(value);
+        }
+
+        reference push_back(value_type&& value) {
+            return emplace_back(std::move(value));
+        }
+
+        // appends count elements at adjacent indices, returning an iterator to the first one
+        iterator grow_by(size_type count) {
+            return _grow_by(count);
+        }
+
+        iterator grow_by(size_type count, const_reference value) {
+            return _grow_by(count, value);
+        }
+
+        template <std::forward_iterator It>
+        iterator grow_by(It first, It last) {
+            _check_intact();
+            auto count{ static_cast<size_type>(std::ranges::distance(first, last)) };
+            size_type index{ _claimed.fetch_add(count) };
+            assert(index + count <= max_size());
+            for (size_type i{}; i != count; ++i, ++first) {
+                _construct(index + i, *first);
+            }
+            _publish();
+            return { this, index };
+        }
+
+        // the remaining members must not run concurrently with any other access
+
+        void swap(ConcurrentVector& other) noexcept {
+            if constexpr (SegmentTraits::propagate_on_container_swap::value) {
+                std::ranges::swap(_alloc, other._alloc);
+            }
+            else {
+                assert(_alloc == other._alloc);
+            }
+            for (size_type i{}; i != _max_segments; ++i) {
+                _table[i].store(other._table[i].exchange(_table[i].load(std::memory_order::relaxed), std::memory_order::relaxed), std::memory_order::relaxed);
+            }
+            _claimed.store(other._claimed.exchange(_claimed.load(std::memory_order::relaxed), std::memory_order::relaxed), std::memory_order::relaxed);
+            _size.store(other._size.exchange(_size.load(std::memory_order::relaxed), std::memory_order::relaxed), std::memory_order::relaxed);
+            _broken.store(other._broken.exchange(_broken.load(std::memory_order::relaxed), std::memory_order::relaxed), std::memory_order::relaxed);
+        }
+
+        friend void swap(ConcurrentVector& left, ConcurrentVector& right) noexcept {
+            left.swap(right);
+        }
+
+        // keeps the segments for reuse, and makes a vector whose append failed usable again
+        void clear() {
+            for (size_type i{}, claimed{ _claimed.load(std::memory_order::relaxed) }; i != claimed; ++i) {
+                size_type segment_index{ _segment_of(i) }, offset{ i - _segment_start(segment_index) };
+                Segment* segment{ _table[segment_index].load(std::memory_order::relaxed) };
+                if (segment != nullptr && segment->ready.begin()[offset].exchange(false, std::memory_order::relaxed)) {
+                    std::ranges::destroy_at(segment->values.begin() + offset);
+                }
+            }
+            _claimed.store(0, std::memory_order::relaxed);
+            _size.store(0, std::memory_order::relaxed);
+            _broken.store(false, std::memory_order::relaxed);
+        }
+
+        friend bool operator==(const ConcurrentVector& left, const ConcurrentVector& right) {
+            return std::ranges::equal(left, right);
+        }
+
+        friend auto operator<=>(const ConcurrentVector& left, const ConcurrentVector& right) {
+            return std::lexicographical_compare_three_way(left.begin(), left.end(), right.begin(), right.end());
+        }
+    };
+
+    template <class It>
+    ConcurrentVector(It, It) -> ConcurrentVector<std::iter_value_t<It>>;
+
+    template <class It, class Alloc>
+    ConcurrentVector(It, It, Alloc) -> ConcurrentVector<std::iter_value_t<It>, Alloc>;
+
+}
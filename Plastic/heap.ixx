@@ -5,6 +5,7 @@ module;
 export module plastic.heap;
 
 import std;
+import plastic.memory;
 
 namespace plastic {
 
@@ -20,6 +21,11 @@ namespace plastic {
         struct Node {
             size_type index{};
             value_type value;
+
+            template <class... Args>
+            Node(size_type index, Args&&... args) :
+                index{ index },
+                value(std::forward<Args>(args)...) {}
         };
 
     public:
@@ -183,6 +189,17 @@ namespace plastic {
             return _data.size();
         }
 
+        // each element lives in its own node behind a pointer in _data
+        MemoryStats memory_stats() const {
+            return {
+                .elements = size(),
+                .nodes = size(),
+                .allocations = (_data.capacity() != 0) + size(),
+                .bytes_allocated = _data.capacity() * sizeof(std::unique_ptr<Node>) + size() * sizeof(Node),
+                .bytes_used = size() * sizeof(value_type)
+            };
+        }
+
         void clear() {
             _data.clear();
         }
@@ -212,14 +229,23 @@ namespace plastic {
             return *apex();
         }
 
-        handle push(const_reference value) {
-            auto ptr{ std::make_unique<Node>(size(), value) };
+        template <class... Args>
+        handle emplace(Args&&... args) {
+            auto ptr{ std::make_unique<Node>(size(), std::forward<Args>(args)...) };
             Node* raw{ ptr.get() };
             _data.emplace_back(std::move(ptr));
             this->_sift_up(raw->index);
             return { raw, this };
         }
 
+        handle push(const_reference value) {
+            return emplace(value);
+        }
+
+        handle push(value_type&& value) {
+            return emplace(std::move(value));
+        }
+
         void pop() {
             assert(!empty());
             if (size() == 1) {
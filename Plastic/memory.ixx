@@ -0,0 +1,810 @@
+module;
+
+#include <cassert>
+#include <cerrno>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+export module plastic.memory;
+
+import std;
+
+namespace plastic {
+
+    export template <class T>
+    struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+    export template <class T>
+    constexpr bool is_trivially_relocatable_v{ is_trivially_relocatable<T>::value };
+
+    template <class T>
+    struct is_trivially_relocatable<std::allocator<T>> : std::true_type {};
+
+    template <class T>
+    struct is_trivially_relocatable<std::pmr::polymorphic_allocator<T>> : std::true_type {};
+
+    template <class T, class D>
+    struct is_trivially_relocatable<std::unique_ptr<T, D>> : is_trivially_relocatable<D> {};
+
+    template <class T>
+    struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+    template <class T>
+    struct is_trivially_relocatable<std::weak_ptr<T>> : std::true_type {};
+
+    export template <class T>
+    T* uninitialized_relocate(T* first, T* last, T* dest) {
+        if constexpr (is_trivially_relocatable_v<T>) {
+            if (first != last) {
+                std::memmove(static_cast<void*>(dest), static_cast<const void*>(first), (last - first) * sizeof(T));
+            }
+            return dest + (last - first);
+        }
+        else {
+            T* dest_last{ std::ranges::uninitialized_move(first, last, dest, std::unreachable_sentinel).out };
+            std::ranges::destroy(first, last);
+            return dest_last;
+        }
+    }
+
+    // bytes_used counts the elements themselves, everything else allocated is overhead
+    export struct MemoryStats {
+        std::size_t elements{};
+        std::size_t nodes{};
+        std::size_t allocations{};
+        std::size_t bytes_allocated{};
+        std::size_t bytes_used{};
+
+        std::size_t slack() const {
+            return bytes_allocated - bytes_used;
+        }
+
+        double bytes_per_element() const {
+            return elements == 0 ? 0 : static_cast<double>(bytes_allocated) / static_cast<double>(elements);
+        }
+    };
+
+    export template <class T, class Alloc = std::allocator<T>>
+    class Storage {
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using size_type = std::size_t;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+
+        static constexpr bool is_reallocatable{
+            std::same_as<allocator_type, std::allocator<value_type>>
+            && std::is_trivially_copyable_v<value_type>
+            && alignof(value_type) <= alignof(std::max_align_t)
+        };
+
+    private:
+        using Traits = std::allocator_traits<allocator_type>;
+
+#ifdef _MSC_VER
+        [[msvc::no_unique_address]]
+#else
+        [[no_unique_address]]
+#endif
+        allocator_type _alloc;
+        pointer _ptr{};
+        size_type _size{};
+
+    public:
+        Storage() = default;
+
+        explicit Storage(const allocator_type& alloc) :
+            _alloc{ alloc } {}
+
+        explicit Storage(size_type size, const allocator_type& alloc = allocator_type()) :
+            _alloc{ alloc } {
+
+            if (size != 0) {
+                if constexpr (is_reallocatable) {
+                    _ptr = static_cast<pointer>(std::malloc(size * sizeof(value_type)));
+                    if (_ptr == nullptr) {
+                        throw std::bad_alloc{};
+                    }
+                }
+                else {
+                    _ptr = Traits::allocate(_alloc, size);
+                }
+                _size = size;
+            }
+        }
+
+        Storage(Storage&& other) noexcept :
+            _alloc{ other._alloc },
+            _ptr{ std::exchange(other._ptr, nullptr) },
+            _size{ std::exchange(other._size, 0) } {}
+
+        ~Storage() {
+            if (_ptr != nullptr) {
+                if constexpr (is_reallocatable) {
+                    std::free(_ptr);
+                }
+                else {
+                    Traits::deallocate(_alloc, _ptr, _size);
+                }
+            }
+        }
+
+        Storage& operator=(Storage&& other) noexcept {
+            this->swap(other);
+            return *this;
+        }
+
+        allocator_type get_allocator() const {
+            return _alloc;
+        }
+
+        pointer begin() {
+            return _ptr;
+        }
+
+        const_pointer begin() const {
+            return _ptr;
+        }
+
+        pointer end() {
+            return _ptr + _size;
+        }
+
+        const_pointer end() const {
+            return _ptr + _size;
+        }
+
+        size_type size() const {
+            return _size;
+        }
+
+        void reallocate(size_type new_size) requires is_reallocatable {
+            assert(new_size != 0);
+            auto new_ptr{ static_cast<pointer>(std::realloc(_ptr, new_size * sizeof(value_type))) };
+            if (new_ptr == nullptr) {
+                throw std::bad_alloc{};
+            }
+            _ptr = new_ptr;
+            _size = new_size;
+        }
+
+        void swap(Storage& other) noexcept {
+            if constexpr (Traits::propagate_on_container_swap::value) {
+                std::ranges::swap(_alloc, other._alloc);
+            }
+            else {
+                assert(_alloc == other._alloc);
+            }
+            std::ranges::swap(_ptr, other._ptr);
+            std::ranges::swap(_size, other._size);
+        }
+
+        friend void swap(Storage& left, Storage& right) noexcept {
+            left.swap(right);
+        }
+    };
+
+    // elements of a file mapped into memory, the storage always spans the whole file
+    export template <class T>
+        requires std::is_trivially_copyable_v<T>
+    class MappedStorage {
+    public:
+        using value_type = T;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using size_type = std::size_t;
+
+        static constexpr bool is_reallocatable{ true };
+
+    private:
+#ifdef _WIN32
+        HANDLE _file{ INVALID_HANDLE_VALUE };
+        HANDLE _mapping{};
+#else
+        int _file{ -1 };
+#endif
+        bool _huge_pages{};
+        pointer _begin{};
+        pointer _end{};
+
+        static std::system_error _last_error(const char* what) {
+#ifdef _WIN32
+            return std::system_error(static_cast<int>(GetLastError()), std::system_category(), what);
+#else
+            return std::system_error(errno, std::generic_category(), what);
+#endif
+        }
+
+        void _advise() noexcept {
+#ifdef MADV_HUGEPAGE
+            if (_huge_pages) {
+                madvise(_begin, size() * sizeof(value_type), MADV_HUGEPAGE);
+            }
+#endif
+        }
+
+        void _map(size_type size) {
+            if (size == 0) {
+                return;
+            }
+
+            std::uint64_t bytes{ size * sizeof(value_type) };
+#ifdef _WIN32
+            _mapping = CreateFileMappingW(_file, nullptr, PAGE_READWRITE, static_cast<DWORD>(bytes >> 32), static_cast<DWORD>(bytes), nullptr);
+            if (_mapping == nullptr) {
+                throw _last_error("CreateFileMapping");
+            }
+            void* ptr{ MapViewOfFile(_mapping, FILE_MAP_ALL_ACCESS, 0, 0, static_cast<SIZE_T>(bytes)) };
+            if (ptr == nullptr) {
+                std::system_error error{ _last_error("MapViewOfFile") };
+                CloseHandle(std::exchange(_mapping, nullptr));
+                throw error;
+            }
+#else
+            void* ptr{ mmap(nullptr, static_cast<std::size_t>(bytes), PROT_READ | PROT_WRITE, MAP_SHARED, _file, 0) };
+            if (ptr == MAP_FAILED) {
+                throw _last_error("mmap");
+            }
+#endif
+            _begin = static_cast<pointer>(ptr);
+            _end = _begin + size;
+            _advise();
+        }
+
+        void _unmap() noexcept {
+            if (_begin == nullptr) {
+                return;
+            }
+
+#ifdef _WIN32
+            UnmapViewOfFile(_begin);
+            CloseHandle(std::exchange(_mapping, nullptr));
+#else
+            munmap(_begin, size() * sizeof(value_type));
+#endif
+            _begin = _end = nullptr;
+        }
+
+        bool _truncate(size_type size) noexcept {
+            std::uint64_t bytes{ size * sizeof(value_type) };
+#ifdef _WIN32
+            LARGE_INTEGER offset{ .QuadPart = static_cast<LONGLONG>(bytes) };
+            return SetFilePointerEx(_file, offset, nullptr, FILE_BEGIN) && SetEndOfFile(_file);
+#else
+            return ftruncate(_file, static_cast<off_t>(bytes)) == 0;
+#endif
+        }
+
+        void _close() noexcept {
+            if (!is_open()) {
+                return;
+            }
+
+#ifdef _WIN32
+            CloseHandle(std::exchange(_file, INVALID_HANDLE_VALUE));
+#else
+            ::close(std::exchange(_file, -1));
+#endif
+        }
+
+    public:
+        MappedStorage() = default;
+
+        // opens or creates the file; huge pages are only a hint, which Linux follows for shared file mappings just on
+        // a tmpfs mounted with huge=, and Windows does not support for file mappings at all
+        explicit MappedStorage(const std::filesystem::path& path, bool huge_pages = false) :
+            _huge_pages{ huge_pages } {
+
+            std::uint64_t bytes;
+#ifdef _WIN32
+            _file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (_file == INVALID_HANDLE_VALUE) {
+                throw _last_error("CreateFile");
+            }
+            LARGE_INTEGER file_size;
+            if (!GetFileSizeEx(_file, &file_size)) {
+                std::system_error error{ _last_error("GetFileSizeEx") };
+                _close();
+                throw error;
+            }
+            bytes = static_cast<std::uint64_t>(file_size.QuadPart);
+#else
+            _file = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if (_file == -1) {
+                throw _last_error("open");
+            }
+            struct stat file_stat;
+            if (fstat(_file, &file_stat) != 0) {
+                std::system_error error{ _last_error("fstat") };
+                _close();
+                throw error;
+            }
+            bytes = static_cast<std::uint64_t>(file_stat.st_size);
+#endif
+
+            try {
+                _map(static_cast<size_type>(bytes / sizeof(value_type)));
+            }
+            catch (...) {
+                _close();
+                throw;
+            }
+        }
+
+        MappedStorage(const MappedStorage&) = delete;
+
+        MappedStorage(MappedStorage&& other) noexcept {
+            this->swap(other);
+        }
+
+        ~MappedStorage() {
+            _unmap();
+            _close();
+        }
+
+        MappedStorage& operator=(const MappedStorage&) = delete;
+
+        MappedStorage& operator=(MappedStorage&& other) noexcept {
+            this->swap(other);
+            return *this;
+        }
+
+        bool is_open() const {
+#ifdef _WIN32
+            return _file != INVALID_HANDLE_VALUE;
+#else
+            return _file != -1;
+#endif
+        }
+
+        pointer begin() {
+            return _begin;
+        }
+
+        const_pointer begin() const {
+            return _begin;
+        }
+
+        pointer end() {
+            return _end;
+        }
+
+        const_pointer end() const {
+            return _end;
+        }
+
+        size_type size() const {
+            return static_cast<size_type>(_end - _begin);
+        }
+
+        // resizes the file and the mapping, on Linux the mapping grows in place when possible
+        void reallocate(size_type new_size) {
+            if (!is_open()) {
+                throw std::system_error(std::make_error_code(std::errc::bad_file_descriptor), "MappedStorage has no open file");
+            }
+            size_type old_size{ size() };
+            if (new_size == old_size) {
+                return;
+            }
+
+#ifdef __linux__
+            if (old_size != 0 && new_size != 0) {
+                if (new_size > old_size && !_truncate(new_size)) {
+                    throw _last_error("ftruncate");
+                }
+                void* ptr{ mremap(_begin, old_size * sizeof(value_type), new_size * sizeof(value_type), MREMAP_MAYMOVE) };
+                if (ptr == MAP_FAILED) {
+                    std::system_error error{ _last_error("mremap") };
+                    _truncate(old_size);
+                    throw error;
+                }
+                _begin = static_cast<pointer>(ptr);
+                _end = _begin + new_size;
+                _advise();
+                if (new_size < old_size) {
+                    _truncate(new_size);
+                }
+                return;
+            }
+#endif
+
+            _unmap();
+            if (!_truncate(new_size)) {
+                std::system_error error{ _last_error("truncate") };
+                _map(old_size);
+                throw error;
+            }
+            _map(new_size);
+        }
+
+        void flush() {
+            if (_begin == nullptr) {
+                return;
+            }
+
+#ifdef _WIN32
+            if (!FlushViewOfFile(_begin, 0) || !FlushFileBuffers(_file)) {
+                throw _last_error("FlushViewOfFile");
+            }
+#else
+            if (msync(_begin, size() * sizeof(value_type), MS_SYNC) != 0) {
+                throw _last_error("msync");
+            }
+#endif
+        }
+
+        // unmaps and closes the file, keeping only its first size elements
+        void close(size_type size) noexcept {
+            if (!is_open()) {
+                return;
+            }
+
+            _unmap();
+            _truncate(size);
+            _close();
+        }
+
+        void swap(MappedStorage& other) noexcept {
+            std::ranges::swap(_file, other._file);
+#ifdef _WIN32
+            std::ranges::swap(_mapping, other._mapping);
+#endif
+            std::ranges::swap(_huge_pages, other._huge_pages);
+            std::ranges::swap(_begin, other._begin);
+            std::ranges::swap(_end, other._end);
+        }
+
+        friend void swap(MappedStorage& left, MappedStorage& right) noexcept {
+            left.swap(right);
+        }
+    };
+
+    export template <class T, class Alloc = std::allocator<T>>
+    class NodePool {
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using size_type = std::size_t;
+
+    private:
+        union Slot {
+            Slot* next;
+            value_type value;
+
+            Slot() {}
+
+            ~Slot() {}
+        };
+
+        struct Chunk {
+            Chunk* next;
+            size_type size;
+        };
+
+        // pools merged by share() forward to a common block, which is freed with its last reference
+        struct Block {
+            size_type refs{ 1 };
+            Block* parent{};
+            Chunk* chunks{};
+            Slot* free{};
+            Slot* cur{};
+            Slot* end{};
+            size_type free_count{};
+            size_type next_size{ 16 };
+        };
+
+        using SlotAlloc = std::allocator_traits<allocator_type>::template rebind_alloc<Slot>;
+        using SlotTraits = std::allocator_traits<SlotAlloc>;
+        using BlockAlloc = std::allocator_traits<allocator_type>::template rebind_alloc<Block>;
+        using BlockTraits = std::allocator_traits<BlockAlloc>;
+
+        static constexpr size_type _header_size{ (sizeof(Chunk) + sizeof(Slot) - 1) / sizeof(Slot) };
+        static constexpr size_type _max_chunk_size{ 4096 };
+
+#ifdef _MSC_VER
+        [[msvc::no_unique_address]]
+#else
+        [[no_unique_address]]
+#endif
+        SlotAlloc _alloc;
+        Block* _block{};
+        size_type _reserved{};
+
+        Block* _root() {
+            if (_block == nullptr) {
+                BlockAlloc alloc{ _alloc };
+                _block = BlockTraits::allocate(alloc, 1);
+                BlockTraits::construct(alloc, _block);
+                return _block;
+            }
+
+            Block* root{ _block };
+            while (root->parent != nullptr) {
+                root = root->parent;
+            }
+            if (root != _block) {
+                ++root->refs;
+                _unref(std::exchange(_block, root));
+            }
+            return root;
+        }
+
+        void _unref(Block* block) noexcept {
+            BlockAlloc alloc{ _alloc };
+            while (block != nullptr && --block->refs == 0) {
+                while (block->chunks != nullptr) {
+                    Chunk* chunk{ std::exchange(block->chunks, block->chunks->next) };
+                    SlotTraits::deallocate(_alloc, reinterpret_cast<Slot*>(chunk), chunk->size);
+                }
+                Block* parent{ block->parent };
+                BlockTraits::destroy(alloc, block);
+                BlockTraits::deallocate(alloc, block, 1);
+                block = parent;
+            }
+        }
+
+        static void _push(Block* block, Slot* slot) noexcept {
+            slot->next = block->free;
+            block->free = slot;
+            ++block->free_count;
+        }
+
+        static Slot* _pop(Block* block) noexcept {
+            --block->free_count;
+            return std::exchange(block->free, block->free->next);
+        }
+
+        void _add_chunk(Block* block, size_type count) {
+            size_type size{ count + _header_size };
+            Slot* slots{ SlotTraits::allocate(_alloc, size) };
+            while (block->cur != block->end) {
+                _push(block, block->cur++);
+            }
+
+            block->chunks = ::new (static_cast<void*>(slots)) Chunk{ block->chunks, size };
+            block->cur = slots + _header_size;
+            block->end = slots + size;
+            block->next_size = std::ranges::min(block->next_size * 2, _max_chunk_size);
+        }
+
+    public:
+        NodePool() = default;
+
+        explicit NodePool(const allocator_type& alloc) :
+            _alloc{ alloc } {}
+
+        NodePool(const NodePool&) = delete;
+
+        NodePool(NodePool&& other) noexcept :
+            _alloc{ other._alloc } {
+
+            this->swap(other);
+        }
+
+        ~NodePool() {
+            release();
+        }
+
+        NodePool& operator=(const NodePool&) = delete;
+
+        NodePool& operator=(NodePool&& other) noexcept {
+            this->swap(other);
+            return *this;
+        }
+
+        allocator_type get_allocator() const {
+            return allocator_type(_alloc);
+        }
+
+        value_type* allocate() {
+            Block* block{ _root() };
+            if (_reserved != 0) {
+                --_reserved;
+                if (block->cur != block->end) {
+                    return std::addressof((block->cur++)->value);
+                }
+            }
+            if (block->free != nullptr) {
+                return std::addressof(_pop(block)->value);
+            }
+
+            if (block->cur == block->end) {
+                _add_chunk(block, block->next_size);
+            }
+            return std::addressof((block->cur++)->value);
+        }
+
+        void deallocate(value_type* ptr) noexcept {
+            assert(_block != nullptr);
+            _push(_root(), reinterpret_cast<Slot*>(ptr));
+        }
+
+        // the next count allocations of this pool do not throw, and come from adjacent slots as long as the chunk
+        // has room; a new chunk is only added when the freed slots do not suffice either
+        void reserve(size_type count) {
+            Block* block{ _root() };
+            if (static_cast<size_type>(block->end - block->cur) + block->free_count < count) {
+                _add_chunk(block, std::ranges::max(count, block->next_size));
+            }
+            _reserved = count;
+        }
+
+        // afterwards both pools allocate from the same chunks, so nodes may move between their owners, until all but
+        // one of the pools sharing them are released
+        void share(NodePool& other) {
+            assert(_alloc == other._alloc);
+            Block *root{ _root() }, *other_root{ other._root() };
+            if (root == other_root) {
+                return;
+            }
+
+            while (other_root->free != nullptr) {
+                _push(root, _pop(other_root));
+            }
+            while (other_root->cur != other_root->end) {
+                _push(root, other_root->cur++);
+            }
+            while (other_root->chunks != nullptr) {
+                Chunk* chunk{ std::exchange(other_root->chunks, other_root->chunks->next) };
+                chunk->next = std::exchange(root->chunks, chunk);
+            }
+            other_root->parent = root;
+            ++root->refs;
+            other._root();
+        }
+
+        // a new pool allocating from the same chunks, without allocating itself unless this pool is still empty
+        NodePool share() {
+            NodePool other{ get_allocator() };
+            other._block = _root();
+            ++other._block->refs;
+            return other;
+        }
+
+        // whether another pool allocates from the same chunks, which then outlive release()
+        bool shared() const {
+            return _block != nullptr && (_block->parent != nullptr || _block->refs != 1);
+        }
+
+        // counts the chunks of all pools sharing them, live nodes are left to the owner
+        MemoryStats memory_stats() const {
+            MemoryStats stats;
+            if (_block == nullptr) {
+                return stats;
+            }
+
+            const Block* root{ _block };
+            while (root->parent != nullptr) {
+                root = root->parent;
+            }
+            stats.allocations = 1;
+            stats.bytes_allocated = sizeof(Block);
+            for (const Chunk* i{ root->chunks }; i != nullptr; i = i->next) {
+                ++stats.allocations;
+                stats.bytes_allocated += i->size * sizeof(Slot);
+            }
+            return stats;
+        }
+
+        // drops this pool's chunks, which are freed at once unless they are shared with another pool
+        void release() noexcept {
+            _unref(std::exchange(_block, nullptr));
+            _reserved = 0;
+        }
+
+        void swap(NodePool& other) noexcept {
+            if constexpr (SlotTraits::propagate_on_container_swap::value) {
+                std::ranges::swap(_alloc, other._alloc);
+            }
+            else {
+                assert(_alloc == other._alloc);
+            }
+            std::ranges::swap(_block, other._block);
+            std::ranges::swap(_reserved, other._reserved);
+        }
+
+        friend void swap(NodePool& left, NodePool& right) noexcept {
+            left.swap(right);
+        }
+    };
+
+    export class MonotonicArena final : public std::pmr::memory_resource {
+        struct Chunk {
+            Chunk* next;
+            std::size_t size;
+        };
+
+        std::pmr::memory_resource* _upstream;
+        Chunk* _chunks{};
+        std::byte* _cur{};
+        std::size_t _left{};
+        std::size_t _next_size;
+
+        void* do_allocate(std::size_t bytes, std::size_t align) override {
+            void* ptr{ _cur };
+            if (std::align(align, bytes, ptr, _left) == nullptr) {
+                std::size_t size{ std::ranges::max(_next_size, bytes + align + sizeof(Chunk)) };
+                auto chunk{ static_cast<Chunk*>(_upstream->allocate(size, alignof(std::max_align_t))) };
+                _chunks = ::new (chunk) Chunk{ _chunks, size };
+                _cur = reinterpret_cast<std::byte*>(chunk + 1);
+                _left = size - sizeof(Chunk);
+                _next_size = size + (size >> 1);
+
+                ptr = _cur;
+                std::align(align, bytes, ptr, _left);
+            }
+
+            _cur = static_cast<std::byte*>(ptr) + bytes;
+            _left -= bytes;
+            return ptr;
+        }
+
+        void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == std::addressof(other);
+        }
+
+    public:
+        explicit MonotonicArena(std::size_t initial_size = 4096, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) :
+            _upstream{ upstream },
+            _next_size{ initial_size } {}
+
+        MonotonicArena(const MonotonicArena&) = delete;
+
+        ~MonotonicArena() {
+            release();
+        }
+
+        MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+        void release() {
+            while (_chunks != nullptr) {
+                Chunk* chunk{ std::exchange(_chunks, _chunks->next) };
+                _upstream->deallocate(chunk, chunk->size, alignof(std::max_align_t));
+            }
+            _cur = nullptr;
+            _left = 0;
+        }
+    };
+
+    export template <class T>
+    class ArenaAllocator {
+        MonotonicArena* _arena;
+
+    public:
+        using value_type = T;
+
+        ArenaAllocator(MonotonicArena& arena) noexcept :
+            _arena{ std::addressof(arena) } {}
+
+        template <class U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept :
+            _arena{ other.arena() } {}
+
+        T* allocate(std::size_t count) {
+            return static_cast<T*>(_arena->allocate(count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, std::size_t) noexcept {}
+
+        MonotonicArena* arena() const noexcept {
+            return _arena;
+        }
+
+        friend bool operator==(const ArenaAllocator& left, const ArenaAllocator& right) noexcept {
+            return left._arena == right._arena;
+        }
+    };
+
+}
@@ -1,6 +1,8 @@
 export module plastic;
 
 export import plastic.algorithm;
+export import plastic.memory;
 export import plastic.sequence;
 export import plastic.tree;
 export import plastic.heap;
+export import plastic.concurrent;
@@ -5,86 +5,386 @@ module;
 export module plastic.sequence;
 
 import std;
+import plastic.memory;
 
 namespace plastic {
 
     template <class T>
-    class Storage {
+    class VectorBase {
     public:
         using value_type = T;
-        using size_type = std::size_t;
         using pointer = value_type*;
         using const_pointer = const value_type*;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = pointer;
+        using const_iterator = const_pointer;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
-    private:
-#ifdef _MSC_VER
-        [[msvc::no_unique_address]]
-#else
-        [[no_unique_address]] 
-#endif
-        std::allocator<value_type> _alloc;
-        pointer _ptr{};
+    protected:
         size_type _size{};
 
-    public:
-        Storage() = default;
+        void _grow(this auto& self, size_type new_capacity) {
+            using Data = std::remove_cvref_t<decltype(self._data)>;
 
-        explicit Storage(size_type size) {
-            if (size != 0) {
-                _ptr = _alloc.allocate(size);
-                _size = size;
+            new_capacity = std::ranges::max(new_capacity, self.capacity() + (self.capacity() >> 1));
+            if constexpr (Data::is_reallocatable) {
+                if (self.begin() == self._data.begin()) {
+                    self._data.reallocate(new_capacity);
+                    return;
+                }
             }
+
+            Data new_data{ new_capacity, self.get_allocator() };
+            uninitialized_relocate(self.begin(), self.end(), new_data.begin());
+            self._data = std::move(new_data);
         }
 
-        Storage(Storage&& other) noexcept {
-            this->swap(other);
+        template <class... Args>
+        void _grow_emplace_back(this auto& self, Args&&... args) {
+            using Data = std::remove_cvref_t<decltype(self._data)>;
+
+            size_type new_capacity{ std::ranges::max(self.size() + 1, self.capacity() + (self.capacity() >> 1)) };
+            if constexpr (Data::is_reallocatable) {
+                if (self.begin() == self._data.begin()) {
+                    value_type value(std::forward<Args>(args)...);
+                    self._data.reallocate(new_capacity);
+                    std::ranges::construct_at(self.end(), std::move(value));
+                    return;
+                }
+            }
+
+            // the arguments may refer to elements, so construct before relocating
+            Data new_data{ new_capacity, self.get_allocator() };
+            pointer new_back{ new_data.begin() + self.size() };
+            std::ranges::construct_at(new_back, std::forward<Args>(args)...);
+            try {
+                uninitialized_relocate(self.begin(), self.end(), new_data.begin());
+            }
+            catch (...) {
+                std::ranges::destroy_at(new_back);
+                throw;
+            }
+            self._data = std::move(new_data);
         }
 
-        ~Storage() {
-            if (_ptr != nullptr) {
-                _alloc.deallocate(_ptr, _size);
+        template <class... Args>
+            requires (sizeof...(Args) <= 1)
+        void _resize(this auto& self, size_type new_size, const Args&... args) {
+            if (new_size > self.capacity()) {
+                self._grow(new_size);
+            }
+
+            iterator new_end{ self.begin() + new_size };
+            if (new_size <= self.size()) {
+                std::ranges::destroy(new_end, self.end());
+            }
+            else if constexpr (sizeof...(Args) == 0) {
+                std::ranges::uninitialized_value_construct(self.end(), new_end);
+            }
+            else {
+                std::ranges::uninitialized_fill(self.end(), new_end, args...);
             }
+            self._size = new_size;
         }
 
-        Storage& operator=(Storage&& other) noexcept {
-            this->swap(other);
-            return *this;
+    public:
+        auto end(this auto& self) {
+            return self.begin() + self._size;
+        }
+
+        auto rbegin(this auto& self) {
+            return std::reverse_iterator{ self.end() };
+        }
+
+        auto rend(this auto& self) {
+            return std::reverse_iterator{ self.begin() };
         }
 
-        pointer begin() {
-            return _ptr;
+        const_iterator cbegin(this const auto& self) {
+            return self.begin();
         }
 
-        const_pointer begin() const {
-            return _ptr;
+        const_iterator cend(this const auto& self) {
+            return self.end();
         }
 
-        pointer end() {
-            return _ptr + _size;
+        const_reverse_iterator crbegin(this const auto& self) {
+            return self.rbegin();
         }
 
-        const_pointer end() const {
-            return _ptr + _size;
+        const_reverse_iterator crend(this const auto& self) {
+            return self.rend();
+        }
+
+        bool empty() const {
+            return _size == 0;
         }
 
         size_type size() const {
             return _size;
         }
 
-        void swap(Storage& other) noexcept {
-            std::ranges::swap(_ptr, other._ptr);
-            std::ranges::swap(_size, other._size);
+        size_type max_size() const {
+            return static_cast<size_type>(-1) / sizeof(value_type);
         }
 
-        friend void swap(Storage& left, Storage& right) noexcept {
-            left.swap(right);
+        void resize(this auto& self, size_type new_size) {
+            self._resize(new_size);
+        }
+
+        void resize(this auto& self, size_type new_size, const_reference value) {
+            self._resize(new_size, value_type{ value });
+        }
+
+        void reserve(this auto& self, size_type new_capacity) {
+            if (new_capacity > self.capacity()) {
+                self._grow(new_capacity);
+            }
+        }
+
+        // the inline buffer of SmallVector is not allocated and not counted
+        MemoryStats memory_stats(this const auto& self) {
+            return {
+                .elements = self.size(),
+                .allocations = self._data.size() != 0,
+                .bytes_allocated = self._data.size() * sizeof(value_type),
+                .bytes_used = self.size() * sizeof(value_type)
+            };
+        }
+
+        decltype(auto) operator[](this auto& self, size_type index) {
+            assert(index < self.size());
+            return self.begin()[index];
+        }
+
+        decltype(auto) front(this auto& self) {
+            assert(!self.empty());
+            return *self.begin();
+        }
+
+        decltype(auto) back(this auto& self) {
+            assert(!self.empty());
+            return self.end()[-1];
+        }
+
+        auto data(this auto& self) {
+            return self.begin();
+        }
+
+        template <class... Args>
+        decltype(auto) emplace_back(this auto& self, Args&&... args) {
+            if (self.size() == self.capacity()) {
+                self._grow_emplace_back(std::forward<Args>(args)...);
+            }
+            else {
+                std::ranges::construct_at(self.end(), std::forward<Args>(args)...);
+            }
+            ++self._size;
+            return self.back();
+        }
+
+        void push_back(this auto& self, const_reference value) {
+            self.emplace_back(value);
+        }
+
+        void push_back(this auto& self, value_type&& value) {
+            self.emplace_back(std::move(value));
+        }
+
+        void pop_back(this auto& self) {
+            assert(!self.empty());
+            --self._size;
+            std::ranges::destroy_at(self.end());
+        }
+
+        template <class... Args>
+        iterator emplace(this auto& self, const_iterator pos, Args&&... args) {
+            difference_type offset{ pos - self.begin() };
+            if (pos == self.end()) {
+                self.emplace_back(std::forward<Args>(args)...);
+                return self.begin() + offset;
+            }
+
+            value_type value(std::forward<Args>(args)...);
+            if (self.size() == self.capacity()) {
+                self._grow(self.size() + 1);
+            }
+
+            iterator pos_iter{ self.begin() + offset };
+            if constexpr (is_trivially_relocatable_v<value_type> && std::is_nothrow_move_constructible_v<value_type>) {
+                uninitialized_relocate(pos_iter, self.end(), pos_iter + 1);
+                std::ranges::construct_at(pos_iter, std::move(value));
+            }
+            else {
+                std::ranges::construct_at(self.end(), std::move(self.back()));
+                std::ranges::move_backward(pos_iter, self.end() - 1, self.end());
+                *pos_iter = std::move(value);
+            }
+            ++self._size;
+            return pos_iter;
+        }
+
+        iterator insert(this auto& self, const_iterator pos, const_reference value) {
+            return self.emplace(pos, value);
+        }
+
+        iterator insert(this auto& self, const_iterator pos, value_type&& value) {
+            return self.emplace(pos, std::move(value));
+        }
+
+        iterator insert(this auto& self, const_iterator pos, size_type count, const_reference value) {
+            if (count == 0) {
+                return const_cast<iterator>(pos);
+            }
+
+            value_type clone{ value };
+            difference_type offset{ pos - self.begin() };
+            if (self.capacity() - self.size() < count) {
+                self._grow(self.size() + count);
+            }
+
+            iterator pos_iter{ self.begin() + offset }, new_pos{ pos_iter + count }, end{ self.end() };
+            if constexpr (is_trivially_relocatable_v<value_type>) {
+                uninitialized_relocate(pos_iter, end, new_pos);
+                try {
+                    std::ranges::uninitialized_fill(pos_iter, new_pos, clone);
+                }
+                catch (...) {
+                    uninitialized_relocate(new_pos, new_pos + (end - pos_iter), pos_iter);
+                    throw;
+                }
+            }
+            else if (new_pos <= end) {
+                iterator middle{ end - count };
+                std::ranges::uninitialized_move(middle, end, end, std::unreachable_sentinel);
+                std::ranges::move_backward(pos_iter, middle, end);
+                std::ranges::fill(pos_iter, new_pos, clone);
+            }
+            else {
+                std::ranges::uninitialized_move(pos_iter, end, new_pos, std::unreachable_sentinel);
+                std::ranges::fill(pos_iter, end, clone);
+                std::ranges::uninitialized_fill(end, new_pos, clone);
+            }
+            self._size += count;
+            return pos_iter;
+        }
+
+        template <std::input_iterator It>
+        iterator insert(this auto& self, const_iterator pos, It first, It last) {
+            return self.insert_range(pos, std::ranges::subrange(first, last));
+        }
+
+        iterator insert(this auto& self, const_iterator pos, std::initializer_list<value_type> list) {
+            return self.insert_range(pos, list);
+        }
+
+        template <std::ranges::input_range R>
+        iterator insert_range(this auto& self, const_iterator pos, R&& range) {
+            if constexpr (!std::ranges::forward_range<R> && !std::ranges::sized_range<R>) {
+                difference_type pos_offset{ pos - self.begin() }, pos_end_offset{ static_cast<difference_type>(self.size()) };
+                std::ranges::copy(range, std::back_inserter(self));
+
+                iterator pos_iter{ self.begin() + pos_offset }, pos_end{ self.begin() + pos_end_offset };
+                std::ranges::rotate(pos_iter, pos_end, self.end());
+                return pos_iter;
+            }
+            else {
+                auto count{ static_cast<size_type>(std::ranges::distance(range)) };
+                if (count == 0) {
+                    return const_cast<iterator>(pos);
+                }
+
+                difference_type offset{ pos - self.begin() };
+                if (self.capacity() - self.size() < count) {
+                    self._grow(self.size() + count);
+                }
+
+                auto first{ std::ranges::begin(range) };
+                iterator pos_iter{ self.begin() + offset }, new_pos{ pos_iter + count }, end{ self.end() };
+                if constexpr (is_trivially_relocatable_v<value_type>) {
+                    uninitialized_relocate(pos_iter, end, new_pos);
+                    try {
+                        std::ranges::uninitialized_copy_n(first, count, pos_iter, new_pos);
+                    }
+                    catch (...) {
+                        uninitialized_relocate(new_pos, new_pos + (end - pos_iter), pos_iter);
+                        throw;
+                    }
+                }
+                else if (new_pos <= end) {
+                    iterator middle{ end - count };
+                    std::ranges::uninitialized_move(middle, end, end, std::unreachable_sentinel);
+                    std::ranges::move_backward(pos_iter, middle, end);
+                    std::ranges::copy_n(first, count, pos_iter);
+                }
+                else {
+                    std::ranges::uninitialized_move(pos_iter, end, new_pos, std::unreachable_sentinel);
+                    auto middle{ std::ranges::copy_n(first, end - pos_iter, pos_iter).in };
+                    std::ranges::uninitialized_copy_n(middle, count - (end - pos_iter), end, std::unreachable_sentinel);
+                }
+                self._size += count;
+                return pos_iter;
+            }
+        }
+
+        template <std::ranges::input_range R>
+        void append_range(this auto& self, R&& range) {
+            self.insert_range(self.end(), std::forward<R>(range));
+        }
+
+        iterator erase(this auto& self, const_iterator pos) {
+            assert(pos != self.end());
+            auto pos_iter{ const_cast<iterator>(pos) };
+            if constexpr (is_trivially_relocatable_v<value_type>) {
+                std::ranges::destroy_at(pos_iter);
+                uninitialized_relocate(pos_iter + 1, self.end(), pos_iter);
+                --self._size;
+            }
+            else {
+                std::ranges::move(pos_iter + 1, self.end(), pos_iter);
+                self.pop_back();
+            }
+            return pos_iter;
+        }
+
+        iterator erase(this auto& self, const_iterator first, const_iterator last) {
+            auto first_iter{ const_cast<iterator>(first) }, last_iter{ const_cast<iterator>(last) };
+            if (first_iter == last_iter) {
+                return first_iter;
+            }
+
+            if constexpr (is_trivially_relocatable_v<value_type>) {
+                std::ranges::destroy(first_iter, last_iter);
+                uninitialized_relocate(last_iter, self.end(), first_iter);
+                self._size -= last_iter - first_iter;
+            }
+            else {
+                iterator new_end{ std::ranges::move(last_iter, self.end(), first_iter).out };
+                std::ranges::destroy(new_end, self.end());
+                self._size = new_end - self.begin();
+            }
+            return first_iter;
+        }
+
+        void clear(this auto& self) {
+            std::ranges::destroy(self);
+            self._size = 0;
         }
     };
 
-    export template <class T>
-    class Vector {
+    export template <class T, class Alloc = std::allocator<T>>
+    class Vector : public VectorBase<T> {
+        using Base = VectorBase<T>;
+
+        friend Base;
+
     public:
         using value_type = T;
+        using allocator_type = Alloc;
         using pointer = value_type*;
         using const_pointer = const value_type*;
         using reference = value_type&;
@@ -97,114 +397,1831 @@ namespace plastic {
         using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
     private:
-        Storage<value_type> _data;
+        Storage<value_type, allocator_type> _data;
+
+    public:
+        Vector() = default;
+
+        explicit Vector(const allocator_type& alloc) :
+            _data{ alloc } {}
+
+        explicit Vector(size_type size, const allocator_type& alloc = allocator_type()) :
+            _data{ size, alloc } {
+
+            this->_size = size;
+            std::ranges::uninitialized_value_construct(*this);
+        }
+
+        Vector(size_type size, const_reference value, const allocator_type& alloc = allocator_type()) :
+            _data{ size, alloc } {
+
+            this->_size = size;
+            std::ranges::uninitialized_fill(*this, value);
+        }
+
+        template <std::input_iterator It>
+        Vector(It first, It last, const allocator_type& alloc = allocator_type()) :
+            _data{ alloc } {
+
+            this->append_range(std::ranges::subrange(first, last));
+        }
+
+        template <std::ranges::input_range R>
+        Vector(std::from_range_t, R&& range, const allocator_type& alloc = allocator_type()) :
+            _data{ alloc } {
+
+            this->append_range(std::forward<R>(range));
+        }
+
+        Vector(const Vector& other) :
+            Vector(other, std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator())) {}
+
+        Vector(const Vector& other, const allocator_type& alloc) :
+            _data{ other.size(), alloc } {
+
+            this->_size = other.size();
+            std::ranges::uninitialized_copy(other, *this);
+        }
+
+        Vector(Vector&& other) noexcept :
+            _data{ std::move(other._data) } {
+
+            this->_size = std::exchange(other._size, 0);
+        }
+
+        Vector(std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type()) :
+            _data{ list.size(), alloc } {
+
+            this->_size = list.size();
+            std::ranges::uninitialized_copy(list, *this);
+        }
+
+        ~Vector() {
+            this->clear();
+        }
+
+        Vector& operator=(const Vector& other) {
+            Vector temp(other, get_allocator());
+            this->swap(temp);
+            return *this;
+        }
+
+        Vector& operator=(Vector&& other) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value) {
+            if (get_allocator() == other.get_allocator()) {
+                this->swap(other);
+            }
+            else {
+                Vector temp(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()), get_allocator());
+                this->swap(temp);
+            }
+            return *this;
+        }
+
+        Vector& operator=(std::initializer_list<value_type> list) {
+            Vector temp(list, get_allocator());
+            this->swap(temp);
+            return *this;
+        }
+
+        allocator_type get_allocator() const {
+            return _data.get_allocator();
+        }
+
+        iterator begin() {
+            return _data.begin();
+        }
+
+        const_iterator begin() const {
+            return _data.begin();
+        }
+
+        size_type capacity() const {
+            return _data.size();
+        }
+
+        void shrink_to_fit() {
+            if (capacity() == this->size()) {
+                return;
+            }
+
+            if (this->empty()) {
+                _data = Storage<value_type, allocator_type>{ get_allocator() };
+                return;
+            }
+
+            if constexpr (Storage<value_type, allocator_type>::is_reallocatable) {
+                _data.reallocate(this->size());
+            }
+            else {
+                Storage<value_type, allocator_type> new_data{ this->size(), get_allocator() };
+                uninitialized_relocate(begin(), this->end(), new_data.begin());
+                _data = std::move(new_data);
+            }
+        }
+
+        void swap(Vector& other) noexcept {
+            std::ranges::swap(_data, other._data);
+            std::ranges::swap(this->_size, other._size);
+        }
+
+        friend void swap(Vector& left, Vector& right) noexcept {
+            left.swap(right);
+        }
+
+        friend bool operator==(const Vector& left, const Vector& right) {
+            return std::ranges::equal(left, right);
+        }
+
+        friend auto operator<=>(const Vector& left, const Vector& right) {
+            return std::lexicographical_compare_three_way(left.begin(), left.end(), right.begin(), right.end());
+        }
+    };
+
+    template <class It>
+    Vector(It, It) -> Vector<std::iter_value_t<It>>;
+
+    template <class It, class Alloc>
+    Vector(It, It, Alloc) -> Vector<std::iter_value_t<It>, Alloc>;
+
+    template <std::ranges::input_range R>
+    Vector(std::from_range_t, R&&) -> Vector<std::ranges::range_value_t<R>>;
+
+    template <std::ranges::input_range R, class Alloc>
+    Vector(std::from_range_t, R&&, Alloc) -> Vector<std::ranges::range_value_t<R>, Alloc>;
+
+    template <class T, class Alloc>
+    struct is_trivially_relocatable<Vector<T, Alloc>> : is_trivially_relocatable<Alloc> {};
+
+    export template <class T, std::size_t N, class Alloc = std::allocator<T>>
+        requires (N != 0)
+    class SmallVector : public VectorBase<T> {
+        using Base = VectorBase<T>;
+
+        friend Base;
+
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = pointer;
+        using const_iterator = const_pointer;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    private:
+        Storage<value_type, allocator_type> _data;
+
+        union {
+            value_type _buffer[N];
+        };
+
+        bool _is_inline() const {
+            return _data.size() == 0;
+        }
+
+        void _steal(SmallVector& other) {
+            if (!other._is_inline() && get_allocator() == other.get_allocator()) {
+                _data = std::move(other._data);
+                this->_size = std::exchange(other._size, 0);
+                return;
+            }
+
+            this->reserve(other.size());
+            std::ranges::uninitialized_move(other.begin(), other.end(), begin(), std::unreachable_sentinel);
+            this->_size = other.size();
+            other.clear();
+            other._data = Storage<value_type, allocator_type>{ other.get_allocator() };
+        }
+
+    public:
+        SmallVector() {}
+
+        explicit SmallVector(const allocator_type& alloc) :
+            _data{ alloc } {}
+
+        explicit SmallVector(size_type size, const allocator_type& alloc = allocator_type()) :
+            _data{ alloc } {
+
+            this->resize(size);
+        }
+
+        SmallVector(size_type size, const_reference value, const allocator_type& alloc = allocator_type()) :
+            _data{ alloc } {
+
+            this->resize(size, value);
+        }
+
+        template <std::input_iterator It>
+        SmallVector(It first, It last, const allocator_type& alloc = allocator_type()) :
+            _data{ alloc } {
+
+            this->append_range(std::ranges::subrange(first, last));
+        }
+
+        template <std::ranges::input_range R>
+        SmallVector(std::from_range_t, R&& range, const allocator_type& alloc = allocator_type()) :
+            _data{ alloc } {
+
+            this->append_range(std::forward<R>(range));
+        }
+
+        SmallVector(const SmallVector& other) :
+            SmallVector(other, std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator())) {}
+
+        SmallVector(const SmallVector& other, const allocator_type& alloc) :
+            _data{ alloc } {
+
+            this->reserve(other.size());
+            std::ranges::uninitialized_copy(other.begin(), other.end(), begin(), std::unreachable_sentinel);
+            this->_size = other.size();
+        }
+
+        SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<value_type>) :
+            _data{ other.get_allocator() } {
+
+            _steal(other);
+        }
+
+        SmallVector(std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type()) :
+            _data{ alloc } {
+
+            this->reserve(list.size());
+            std::ranges::uninitialized_copy(list.begin(), list.end(), begin(), std::unreachable_sentinel);
+            this->_size = list.size();
+        }
+
+        ~SmallVector() {
+            this->clear();
+        }
+
+        SmallVector& operator=(const SmallVector& other) {
+            SmallVector temp(other, get_allocator());
+            this->swap(temp);
+            return *this;
+        }
+
+        SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<value_type>) {
+            if (this != std::addressof(other)) {
+                this->clear();
+                _data = Storage<value_type, allocator_type>{ get_allocator() };
+                _steal(other);
+            }
+            return *this;
+        }
+
+        SmallVector& operator=(std::initializer_list<value_type> list) {
+            SmallVector temp(list, get_allocator());
+            this->swap(temp);
+            return *this;
+        }
+
+        allocator_type get_allocator() const {
+            return _data.get_allocator();
+        }
+
+        iterator begin() {
+            return _is_inline() ? _buffer : _data.begin();
+        }
+
+        const_iterator begin() const {
+            return _is_inline() ? _buffer : _data.begin();
+        }
+
+        size_type capacity() const {
+            return _is_inline() ? N : _data.size();
+        }
+
+        void swap(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<value_type>) {
+            if (!_is_inline() && !other._is_inline()) {
+                std::ranges::swap(_data, other._data);
+                std::ranges::swap(this->_size, other._size);
+                return;
+            }
+
+            SmallVector temp(std::move(other));
+            other._steal(*this);
+            _steal(temp);
+        }
+
+        friend void swap(SmallVector& left, SmallVector& right) noexcept(std::is_nothrow_move_constructible_v<value_type>) {
+            left.swap(right);
+        }
+
+        friend bool operator==(const SmallVector& left, const SmallVector& right) {
+            return std::ranges::equal(left, right);
+        }
+
+        friend auto operator<=>(const SmallVector& left, const SmallVector& right) {
+            return std::lexicographical_compare_three_way(left.begin(), left.end(), right.begin(), right.end());
+        }
+    };
+
+    template <class T, std::size_t N, class Alloc>
+    struct is_trivially_relocatable<SmallVector<T, N, Alloc>> : std::bool_constant<is_trivially_relocatable_v<T> && is_trivially_relocatable_v<Alloc>> {};
+
+    // a Vector whose elements live in a memory-mapped file, which is trimmed to the elements when closed; growing
+    // one without a file throws
+    export template <class T>
+        requires std::is_trivially_copyable_v<T>
+    class MappedVector : public VectorBase<T> {
+        using Base = VectorBase<T>;
+
+        friend Base;
+
+    public:
+        using value_type = T;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = pointer;
+        using const_iterator = const_pointer;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    private:
+        MappedStorage<value_type> _data;
+
+        // the mapping always grows in place, so these replace the relocating versions of VectorBase
+        void _grow(size_type new_capacity) {
+            _data.reallocate(std::ranges::max(new_capacity, capacity() + (capacity() >> 1)));
+        }
+
+        template <class... Args>
+        void _grow_emplace_back(Args&&... args) {
+            value_type value(std::forward<Args>(args)...);
+            _grow(this->size() + 1);
+            std::ranges::construct_at(this->end(), std::move(value));
+        }
+
+    public:
+        MappedVector() = default;
+
+        // the existing elements of the file are used as they are, huge pages only help on a tmpfs mounted with huge=
+        explicit MappedVector(const std::filesystem::path& path, bool huge_pages = false) :
+            _data{ path, huge_pages } {
+
+            this->_size = _data.size();
+        }
+
+        MappedVector(MappedVector&& other) noexcept :
+            _data{ std::move(other._data) } {
+
+            this->_size = std::exchange(other._size, 0);
+        }
+
+        ~MappedVector() {
+            close();
+        }
+
+        MappedVector& operator=(MappedVector&& other) noexcept {
+            this->swap(other);
+            return *this;
+        }
+
+        bool is_open() const {
+            return _data.is_open();
+        }
+
+        void close() noexcept {
+            _data.close(this->size());
+            this->_size = 0;
+        }
+
+        void flush() {
+            _data.flush();
+        }
+
+        iterator begin() {
+            return _data.begin();
+        }
+
+        const_iterator begin() const {
+            return _data.begin();
+        }
+
+        size_type capacity() const {
+            return _data.size();
+        }
+
+        void shrink_to_fit() {
+            _data.reallocate(this->size());
+        }
+
+        void swap(MappedVector& other) noexcept {
+            std::ranges::swap(_data, other._data);
+            std::ranges::swap(this->_size, other._size);
+        }
+
+        friend void swap(MappedVector& left, MappedVector& right) noexcept {
+            left.swap(right);
+        }
+
+        friend bool operator==(const MappedVector& left, const MappedVector& right) {
+            return std::ranges::equal(left, right);
+        }
+
+        friend auto operator<=>(const MappedVector& left, const MappedVector& right) {
+            return std::lexicographical_compare_three_way(left.begin(), left.end(), right.begin(), right.end());
+        }
+    };
+
+    template <class T, std::size_t N, bool = std::is_trivially_default_constructible_v<T>>
+    struct InplaceStorage {
+        T data[N];
+    };
+
+    // elements are built into the inactive array member, which is only a constant expression from C++26 on, so
+    // InplaceVector is usable in constant expressions just for trivially default constructible T
+    template <class T, std::size_t N>
+    struct InplaceStorage<T, N, false> {
+        union {
+            T data[N];
+        };
+
+        constexpr InplaceStorage() {}
+
+        constexpr ~InplaceStorage()
+            requires std::is_trivially_destructible_v<T>
+        = default;
+
+        constexpr ~InplaceStorage() {}
+    };
+
+    // a vector with a fixed capacity and no allocation, trivially copyable when T is
+    // growing past N throws std::bad_alloc, try_ functions report it instead and unchecked_ ones assert
+    export template <class T, std::size_t N>
+        requires (N != 0)
+    class InplaceVector {
+    public:
+        using value_type = T;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = pointer;
+        using const_iterator = const_pointer;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    private:
+        InplaceStorage<value_type, N> _storage;
+        size_type _size{};
+
+        constexpr void _check_capacity(size_type count) const {
+            if (N - _size < count) {
+                throw std::bad_alloc{};
+            }
+        }
+
+    public:
+        constexpr InplaceVector() = default;
+
+        constexpr explicit InplaceVector(size_type size) {
+            resize(size);
+        }
+
+        constexpr InplaceVector(size_type size, const_reference value) {
+            resize(size, value);
+        }
+
+        template <std::input_iterator It>
+        constexpr InplaceVector(It first, It last) {
+            append_range(std::ranges::subrange(first, last));
+        }
+
+        template <std::ranges::input_range R>
+        constexpr InplaceVector(std::from_range_t, R&& range) {
+            append_range(std::forward<R>(range));
+        }
+
+        constexpr InplaceVector(const InplaceVector&)
+            requires std::is_trivially_copyable_v<value_type>
+        = default;
+
+        constexpr InplaceVector(const InplaceVector& other) {
+            append_range(other);
+        }
+
+        constexpr InplaceVector(InplaceVector&&)
+            requires std::is_trivially_copyable_v<value_type>
+        = default;
+
+        constexpr InplaceVector(InplaceVector&& other) noexcept(std::is_nothrow_move_constructible_v<value_type>) {
+            append_range(std::ranges::subrange(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end())));
+        }
+
+        constexpr InplaceVector(std::initializer_list<value_type> list) {
+            append_range(list);
+        }
+
+        constexpr ~InplaceVector()
+            requires std::is_trivially_destructible_v<value_type>
+        = default;
+
+        constexpr ~InplaceVector() {
+            clear();
+        }
+
+        constexpr InplaceVector& operator=(const InplaceVector&)
+            requires std::is_trivially_copyable_v<value_type>
+        = default;
+
+        constexpr InplaceVector& operator=(const InplaceVector& other) {
+            if (this != std::addressof(other)) {
+                clear();
+                append_range(other);
+            }
+            return *this;
+        }
+
+        constexpr InplaceVector& operator=(InplaceVector&&)
+            requires std::is_trivially_copyable_v<value_type>
+        = default;
+
+        constexpr InplaceVector& operator=(InplaceVector&& other) noexcept(std::is_nothrow_move_constructible_v<value_type>) {
+            if (this != std::addressof(other)) {
+                clear();
+                append_range(std::ranges::subrange(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end())));
+            }
+            return *this;
+        }
+
+        constexpr InplaceVector& operator=(std::initializer_list<value_type> list) {
+            if (list.size() > N) {
+                throw std::bad_alloc{};
+            }
+            clear();
+            append_range(list);
+            return *this;
+        }
+
+        constexpr iterator begin() {
+            return _storage.data;
+        }
+
+        constexpr const_iterator begin() const {
+            return _storage.data;
+        }
+
+        constexpr iterator end() {
+            return begin() + _size;
+        }
+
+        constexpr const_iterator end() const {
+            return begin() + _size;
+        }
+
+        constexpr reverse_iterator rbegin() {
+            return reverse_iterator{ end() };
+        }
+
+        constexpr const_reverse_iterator rbegin() const {
+            return const_reverse_iterator{ end() };
+        }
+
+        constexpr reverse_iterator rend() {
+            return reverse_iterator{ begin() };
+        }
+
+        constexpr const_reverse_iterator rend() const {
+            return const_reverse_iterator{ begin() };
+        }
+
+        constexpr const_iterator cbegin() const {
+            return begin();
+        }
+
+        constexpr const_iterator cend() const {
+            return end();
+        }
+
+        constexpr const_reverse_iterator crbegin() const {
+            return rbegin();
+        }
+
+        constexpr const_reverse_iterator crend() const {
+            return rend();
+        }
+
+        constexpr bool empty() const {
+            return _size == 0;
+        }
+
+        constexpr size_type size() const {
+            return _size;
+        }
+
+        static constexpr size_type max_size() {
+            return N;
+        }
+
+        static constexpr size_type capacity() {
+            return N;
+        }
+
+        constexpr void resize(size_type new_size) {
+            if (new_size > N) {
+                throw std::bad_alloc{};
+            }
+            while (_size > new_size) {
+                pop_back();
+            }
+            while (_size < new_size) {
+                unchecked_emplace_back();
+            }
+        }
+
+        constexpr void resize(size_type new_size, const_reference value) {
+            if (new_size > N) {
+                throw std::bad_alloc{};
+            }
+            while (_size > new_size) {
+                pop_back();
+            }
+            while (_size < new_size) {
+                unchecked_emplace_back(value);
+            }
+        }
+
+        static constexpr void reserve(size_type new_capacity) {
+            if (new_capacity > N) {
+                throw std::bad_alloc{};
+            }
+        }
+
+        static constexpr void shrink_to_fit() {}
+
+        MemoryStats memory_stats() const {
+            return {
+                .elements = _size,
+                .bytes_used = _size * sizeof(value_type)
+            };
+        }
+
+        constexpr reference operator[](size_type index) {
+            assert(index < size());
+            return begin()[index];
+        }
+
+        constexpr const_reference operator[](size_type index) const {
+            assert(index < size());
+            return begin()[index];
+        }
+
+        constexpr reference front() {
+            assert(!empty());
+            return *begin();
+        }
+
+        constexpr const_reference front() const {
+            assert(!empty());
+            return *begin();
+        }
+
+        constexpr reference back() {
+            assert(!empty());
+            return end()[-1];
+        }
+
+        constexpr const_reference back() const {
+            assert(!empty());
+            return end()[-1];
+        }
+
+        constexpr pointer data() {
+            return begin();
+        }
+
+        constexpr const_pointer data() const {
+            return begin();
+        }
+
+        template <class... Args>
+        constexpr reference emplace_back(Args&&... args) {
+            _check_capacity(1);
+            return unchecked_emplace_back(std::forward<Args>(args)...);
+        }
+
+        template <class... Args>
+        constexpr pointer try_emplace_back(Args&&... args) {
+            return _size == N ? nullptr : std::addressof(unchecked_emplace_back(std::forward<Args>(args)...));
+        }
+
+        template <class... Args>
+        constexpr reference unchecked_emplace_back(Args&&... args) {
+            assert(_size != N);
+            std::ranges::construct_at(end(), std::forward<Args>(args)...);
+            ++_size;
+            return back();
+        }
+
+        constexpr void push_back(const_reference value) {
+            emplace_back(value);
+        }
+
+        constexpr void push_back(value_type&& value) {
+            emplace_back(std::move(value));
+        }
+
+        constexpr pointer try_push_back(const_reference value) {
+            return try_emplace_back(value);
+        }
+
+        constexpr pointer try_push_back(value_type&& value) {
+            return try_emplace_back(std::move(value));
+        }
+
+        constexpr reference unchecked_push_back(const_reference value) {
+            return unchecked_emplace_back(value);
+        }
+
+        constexpr reference unchecked_push_back(value_type&& value) {
+            return unchecked_emplace_back(std::move(value));
+        }
+
+        constexpr void pop_back() {
+            assert(!empty());
+            --_size;
+            std::ranges::destroy_at(end());
+        }
+
+        // elements never move when appending, so new ones are built at the end and rotated into place
+        template <class... Args>
+        constexpr iterator emplace(const_iterator pos, Args&&... args) {
+            difference_type offset{ pos - begin() };
+            emplace_back(std::forward<Args>(args)...);
+            std::ranges::rotate(begin() + offset, end() - 1, end());
+            return begin() + offset;
+        }
+
+        constexpr iterator insert(const_iterator pos, const_reference value) {
+            return emplace(pos, value);
+        }
+
+        constexpr iterator insert(const_iterator pos, value_type&& value) {
+            return emplace(pos, std::move(value));
+        }
+
+        constexpr iterator insert(const_iterator pos, size_type count, const_reference value) {
+            _check_capacity(count);
+            difference_type offset{ pos - begin() };
+            size_type old_size{ _size };
+            try {
+                for (size_type i{}; i != count; ++i) {
+                    unchecked_emplace_back(value);
+                }
+            }
+            catch (...) {
+                erase(begin() + old_size, end());
+                throw;
+            }
+            std::ranges::rotate(begin() + offset, end() - count, end());
+            return begin() + offset;
+        }
+
+        template <std::input_iterator It>
+        constexpr iterator insert(const_iterator pos, It first, It last) {
+            return insert_range(pos, std::ranges::subrange(first, last));
+        }
+
+        constexpr iterator insert(const_iterator pos, std::initializer_list<value_type> list) {
+            return insert_range(pos, list);
+        }
+
+        // the elements appended so far are dropped again when one throws
+        template <std::ranges::input_range R>
+        constexpr iterator insert_range(const_iterator pos, R&& range) {
+            difference_type offset{ pos - begin() };
+            size_type old_size{ _size };
+            if constexpr (std::ranges::forward_range<R> || std::ranges::sized_range<R>) {
+                _check_capacity(static_cast<size_type>(std::ranges::distance(range)));
+            }
+            try {
+                for (auto&& i : range) {
+                    if constexpr (std::ranges::forward_range<R> || std::ranges::sized_range<R>) {
+                        unchecked_emplace_back(std::forward<decltype(i)>(i));
+                    }
+                    else {
+                        emplace_back(std::forward<decltype(i)>(i));
+                    }
+                }
+            }
+            catch (...) {
+                erase(begin() + old_size, end());
+                throw;
+            }
+            std::ranges::rotate(begin() + offset, begin() + old_size, end());
+            return begin() + offset;
+        }
+
+        template <std::ranges::input_range R>
+        constexpr void append_range(R&& range) {
+            insert_range(end(), std::forward<R>(range));
+        }
+
+        constexpr iterator erase(const_iterator pos) {
+            assert(pos != end());
+            return erase(pos, pos + 1);
+        }
+
+        constexpr iterator erase(const_iterator first, const_iterator last) {
+            iterator first_iter{ begin() + (first - begin()) }, last_iter{ begin() + (last - begin()) };
+            iterator new_end{ std::ranges::move(last_iter, end(), first_iter).out };
+            std::ranges::destroy(new_end, end());
+            _size = new_end - begin();
+            return first_iter;
+        }
+
+        constexpr void swap(InplaceVector& other) noexcept(std::is_nothrow_swappable_v<value_type> && std::is_nothrow_move_constructible_v<value_type>) {
+            InplaceVector *shorter{ this }, *longer{ std::addressof(other) };
+            if (shorter->size() > longer->size()) {
+                std::ranges::swap(shorter, longer);
+            }
+
+            iterator middle{ std::ranges::swap_ranges(*shorter, *longer).in2 };
+            shorter->append_range(std::ranges::subrange(std::make_move_iterator(middle), std::make_move_iterator(longer->end())));
+            longer->erase(middle, longer->end());
+        }
+
+        friend constexpr void swap(InplaceVector& left, InplaceVector& right) noexcept(noexcept(left.swap(right))) {
+            left.swap(right);
+        }
+
+        constexpr void clear() {
+            std::ranges::destroy(*this);
+            _size = 0;
+        }
+
+        friend constexpr bool operator==(const InplaceVector& left, const InplaceVector& right) {
+            return std::ranges::equal(left, right);
+        }
+
+        friend constexpr auto operator<=>(const InplaceVector& left, const InplaceVector& right) {
+            return std::lexicographical_compare_three_way(left.begin(), left.end(), right.begin(), right.end());
+        }
+    };
+
+    template <class T, std::size_t N>
+    struct is_trivially_relocatable<InplaceVector<T, N>> : is_trivially_relocatable<T> {};
+
+    export template <class T, class Alloc = std::allocator<T>>
+    class Deque {
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        class iterator {
+            friend Deque;
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = value_type*;
+            using reference = value_type&;
+
+        private:
+            Deque* _cont{};
+            pointer _ptr{};
+            bool _wrapped{};
+
+            iterator(Deque* cont) :
+                _cont{ cont },
+                _ptr{ cont->_data.begin() + cont->_first },
+                _wrapped{ cont->capacity() == 0 } {}
+
+            difference_type _offset() const {
+                difference_type diff{ _ptr - _cont->_data.begin() - static_cast<difference_type>(_cont->_first) };
+                return _wrapped ? diff + _cont->capacity() : diff;
+            }
+
+            std::array<std::span<value_type>, 2> _segments(iterator last) const {
+                if (_wrapped == last._wrapped) {
+                    return { std::span{ _ptr, last._ptr }, std::span<value_type>{} };
+                }
+                return { std::span{ _ptr, _cont->_data.end() }, std::span{ _cont->_data.begin(), last._ptr } };
+            }
+
+        public:
+            iterator() = default;
+
+            reference operator*() const {
+                return *_ptr;
+            }
+
+            pointer operator->() const {
+                return _ptr;
+            }
+
+            reference operator[](difference_type index) const {
+                return *(*this + index);
+            }
+
+            friend bool operator==(iterator left, iterator right) {
+                return left._ptr == right._ptr && left._wrapped == right._wrapped;
+            }
+
+            friend auto operator<=>(iterator left, iterator right) {
+                return left._offset() <=> right._offset();
+            }
+
+            iterator& operator+=(difference_type diff) {
+                if (_cont->_data.end() - _ptr <= diff) {
+                    _ptr += diff - _cont->capacity();
+                    _wrapped = true;
+                }
+                else if (_ptr - _cont->_data.begin() < -diff) {
+                    _ptr += diff + _cont->capacity();
+                    _wrapped = false;
+                }
+                else {
+                    _ptr += diff;
+                }
+                return *this;
+            }
+
+            iterator& operator-=(difference_type diff) {
+                return *this += -diff;
+            }
+
+            friend iterator operator+(iterator iter, difference_type diff) {
+                return iter += diff;
+            }
+
+            friend iterator operator+(difference_type diff, iterator iter) {
+                return iter += diff;
+            }
+
+            friend iterator operator-(iterator iter, difference_type diff) {
+                return iter -= diff;
+            }
+
+            friend difference_type operator-(iterator left, iterator right) {
+                return left._offset() - right._offset();
+            }
+
+            friend std::array<std::span<value_type>, 2> segments(iterator first, iterator last) {
+                return first._segments(last);
+            }
+
+            iterator& operator++() {
+                ++_ptr;
+                if (_ptr == _cont->_data.end()) {
+                    _ptr = _cont->_data.begin();
+                    _wrapped = true;
+                }
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator temp{ *this };
+                ++*this;
+                return temp;
+            }
+
+            iterator& operator--() {
+                if (_ptr == _cont->_data.begin()) {
+                    _ptr = _cont->_data.end();
+                    _wrapped = false;
+                }
+                --_ptr;
+                return *this;
+            }
+
+            iterator operator--(int) {
+                iterator temp{ *this };
+                --*this;
+                return temp;
+            }
+        };
+
+        using const_iterator = std::const_iterator<iterator>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    private:
+        Storage<value_type, allocator_type> _data;
+        size_type _first{};
+        size_type _size{};
+
+        void _grow(size_type new_capacity) {
+            new_capacity = std::ranges::max(new_capacity, capacity() + (capacity() >> 1));
+            if constexpr (Storage<value_type, allocator_type>::is_reallocatable) {
+                size_type old_capacity{ capacity() };
+                _data.reallocate(new_capacity);
+                if (_first + _size > old_capacity) {
+                    size_type new_first{ new_capacity - (old_capacity - _first) };
+                    uninitialized_relocate(_data.begin() + _first, _data.begin() + old_capacity, _data.begin() + new_first);
+                    _first = new_first;
+                }
+            }
+            else if constexpr (is_trivially_relocatable_v<value_type>) {
+                Storage<value_type, allocator_type> new_data{ new_capacity, get_allocator() };
+                if (_first + _size <= capacity()) {
+                    uninitialized_relocate(_data.begin() + _first, _data.begin() + _first + _size, new_data.begin());
+                }
+                else {
+                    pointer middle{ uninitialized_relocate(_data.begin() + _first, _data.end(), new_data.begin()) };
+                    uninitialized_relocate(_data.begin(), _data.begin() + (_first + _size - capacity()), middle);
+                }
+
+                _data = std::move(new_data);
+                _first = 0;
+            }
+            else {
+                size_type size{ this->size() };
+                iterator begin{ this->begin() }, end{ this->end() };
+                Storage<value_type, allocator_type> new_data{ new_capacity, get_allocator() };
+                if (!end._wrapped) {
+                    std::ranges::uninitialized_move(begin._ptr, end._ptr, new_data.begin(), std::unreachable_sentinel);
+                }
+                else {
+                    pointer middle{ std::ranges::uninitialized_move(begin._ptr, _data.end(), new_data.begin(), std::unreachable_sentinel).out };
+                    std::ranges::uninitialized_move(_data.begin(), end._ptr, middle, std::unreachable_sentinel);
+                }
+                clear();
+
+                _data = std::move(new_data);
+                _first = 0;
+                _size = size;
+            }
+        }
+
+        template <class... Args>
+            requires (sizeof...(Args) <= 1)
+        void _resize(size_type new_size, const Args&... args) {
+            if (new_size > capacity()) {
+                _grow(new_size);
+            }
+
+            iterator begin{ this->begin() }, end{ this->end() }, new_end{ begin + new_size };
+            if (new_size <= size()) {
+                if (new_end._wrapped == end._wrapped) {
+                    std::ranges::destroy(new_end._ptr, end._ptr);
+                }
+                else {
+                    std::ranges::destroy(new_end._ptr, _data.end());
+                    std::ranges::destroy(_data.begin(), end._ptr);
+                }
+            }
+            else if constexpr (sizeof...(Args) == 0) {
+                if (new_end._wrapped == end._wrapped) {
+                    std::ranges::uninitialized_value_construct(end._ptr, new_end._ptr);
+                }
+                else {
+                    std::ranges::uninitialized_value_construct(end._ptr, _data.end());
+                    std::ranges::uninitialized_value_construct(_data.begin(), new_end._ptr);
+                }
+            }
+            else {
+                if (new_end._wrapped == end._wrapped) {
+                    std::ranges::uninitialized_fill(end._ptr, new_end._ptr, args...);
+                }
+                else {
+                    std::ranges::uninitialized_fill(end._ptr, _data.end(), args...);
+                    std::ranges::uninitialized_fill(_data.begin(), new_end._ptr, args...);
+                }
+            }
+            _size = new_size;
+        }
+
+    public:
+        Deque() = default;
+
+        explicit Deque(const allocator_type& alloc) :
+            _data{ alloc } {}
+
+        explicit Deque(size_type size, const allocator_type& alloc = allocator_type()) :
+            _data{ size, alloc },
+            _size{ size } {
+
+            std::ranges::uninitialized_value_construct(_data);
+        }
+
+        Deque(size_type size, const_reference value, const allocator_type& alloc = allocator_type()) :
+            _data{ size, alloc },
+            _size{ size } {
+
+            std::ranges::uninitialized_fill(_data, value);
+        }
+
+        template <std::input_iterator It>
+        Deque(It first, It last, const allocator_type& alloc = allocator_type()) :
+            _data{ alloc } {
+
+            this->append_range(std::ranges::subrange(first, last));
+        }
+
+        template <std::ranges::input_range R>
+        Deque(std::from_range_t, R&& range, const allocator_type& alloc = allocator_type()) :
+            _data{ alloc } {
+
+            this->append_range(std::forward<R>(range));
+        }
+
+        Deque(const Deque& other) :
+            Deque(other, std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator())) {}
+
+        Deque(const Deque& other, const allocator_type& alloc) :
+            _data{ other.size(), alloc },
+            _size{ other.size() } {
+
+            iterator begin{ other.begin().base() }, end{ other.end().base() };
+            if (!end._wrapped) {
+                std::ranges::uninitialized_copy(begin._ptr, end._ptr, _data.begin(), std::unreachable_sentinel);
+            }
+            else {
+                pointer middle{ std::ranges::uninitialized_copy(begin._ptr, other._data.end(), _data.begin(), std::unreachable_sentinel).out };
+                std::ranges::uninitialized_copy(other._data.begin(), end._ptr, middle, std::unreachable_sentinel);
+            }
+        }
+
+        Deque(Deque&& other) noexcept :
+            _data{ std::move(other._data) },
+            _first{ std::exchange(other._first, 0) },
+            _size{ std::exchange(other._size, 0) } {}
+
+        Deque(std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type()) :
+            _data{ list.size(), alloc },
+            _size{ list.size() } {
+
+            std::ranges::uninitialized_copy(list, _data);
+        }
+
+        ~Deque() {
+            clear();
+        }
+
+        Deque& operator=(const Deque& other) {
+            Deque temp(other, get_allocator());
+            this->swap(temp);
+            return *this;
+        }
+
+        Deque& operator=(Deque&& other) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value) {
+            if (get_allocator() == other.get_allocator()) {
+                this->swap(other);
+            }
+            else {
+                Deque temp(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()), get_allocator());
+                this->swap(temp);
+            }
+            return *this;
+        }
+
+        Deque& operator=(std::initializer_list<value_type> list) {
+            Deque temp(list, get_allocator());
+            this->swap(temp);
+            return *this;
+        }
+
+        allocator_type get_allocator() const {
+            return _data.get_allocator();
+        }
+
+        iterator begin() {
+            return iterator{ this };
+        }
+
+        const_iterator begin() const {
+            return iterator{ const_cast<Deque*>(this) };
+        }
+
+        iterator end() {
+            return iterator{ this } + _size;
+        }
+
+        const_iterator end() const {
+            return iterator{ const_cast<Deque*>(this) } + _size;
+        }
+
+        reverse_iterator rbegin() {
+            return reverse_iterator{ end() };
+        }
+
+        const_reverse_iterator rbegin() const {
+            return const_reverse_iterator{ end() };
+        }
+
+        reverse_iterator rend() {
+            return reverse_iterator{ begin() };
+        }
+
+        const_reverse_iterator rend() const {
+            return const_reverse_iterator{ begin() };
+        }
+
+        const_iterator cbegin() const {
+            return begin();
+        }
+
+        const_iterator cend() const {
+            return end();
+        }
+
+        const_reverse_iterator crbegin() const {
+            return rbegin();
+        }
+
+        const_reverse_iterator crend() const {
+            return rend();
+        }
+
+        bool empty() const {
+            return _size == 0;
+        }
+
+        size_type size() const {
+            return _size;
+        }
+
+        size_type max_size() const {
+            return static_cast<size_type>(-1) / sizeof(value_type);
+        }
+
+        size_type capacity() const {
+            return _data.size();
+        }
+
+        void resize(size_type new_size) {
+            _resize(new_size);
+        }
+
+        void resize(size_type new_size, const_reference value) {
+            this->_resize(new_size, value_type{ value });
+        }
+
+        void reserve(size_type new_capacity) {
+            if (new_capacity > capacity()) {
+                _grow(new_capacity);
+            }
+        }
+
+        MemoryStats memory_stats() const {
+            return {
+                .elements = _size,
+                .allocations = capacity() != 0,
+                .bytes_allocated = capacity() * sizeof(value_type),
+                .bytes_used = _size * sizeof(value_type)
+            };
+        }
+
+        reference operator[](size_type index) {
+            assert(index < size());
+            return begin()[index];
+        }
+
+        const_reference operator[](size_type index) const {
+            assert(index < size());
+            return begin()[index];
+        }
+
+        reference front() {
+            assert(!empty());
+            return *begin();
+        }
+
+        const_reference front() const {
+            assert(!empty());
+            return *begin();
+        }
+
+        reference back() {
+            assert(!empty());
+            return *--end();
+        }
+
+        const_reference back() const {
+            assert(!empty());
+            return *--end();
+        }
+
+        template <class... Args>
+        reference emplace_front(Args&&... args) {
+            if (size() == capacity()) {
+                value_type value(std::forward<Args>(args)...);
+                _grow(size() + 1);
+                return emplace_front(std::move(value));
+            }
+
+            iterator begin{ this->begin() };
+            std::ranges::construct_at((--begin)._ptr, std::forward<Args>(args)...);
+            _first = begin._ptr - _data.begin();
+            ++_size;
+            return *begin;
+        }
+
+        void push_front(const_reference value) {
+            emplace_front(value);
+        }
+
+        void push_front(value_type&& value) {
+            emplace_front(std::move(value));
+        }
+
+        void pop_front() {
+            assert(!empty());
+            iterator begin{ this->begin() };
+            std::ranges::destroy_at(begin++._ptr);
+            _first = begin._ptr - _data.begin();
+            --_size;
+        }
+
+        template <class... Args>
+        reference emplace_back(Args&&... args) {
+            if (size() == capacity()) {
+                value_type value(std::forward<Args>(args)...);
+                _grow(size() + 1);
+                return emplace_back(std::move(value));
+            }
+
+            pointer ptr{ end()._ptr };
+            std::ranges::construct_at(ptr, std::forward<Args>(args)...);
+            ++_size;
+            return *ptr;
+        }
+
+        void push_back(const_reference value) {
+            emplace_back(value);
+        }
+
+        void push_back(value_type&& value) {
+            emplace_back(std::move(value));
+        }
+
+        void pop_back() {
+            assert(!empty());
+            --_size;
+            std::ranges::destroy_at(end()._ptr);
+        }
+
+        template <class... Args>
+        iterator emplace(const_iterator pos, Args&&... args) {
+            difference_type offset{ pos - begin() };
+            if (pos == end()) {
+                emplace_back(std::forward<Args>(args)...);
+                return begin() + offset;
+            }
+
+            value_type value(std::forward<Args>(args)...);
+            if (size() == capacity()) {
+                _grow(size() + 1);
+            }
+
+            iterator begin{ this->begin() }, end{ this->end() }, pos_iter{ begin + offset };
+            std::ranges::construct_at(end._ptr, std::move(back()));
+            std::ranges::move_backward(pos_iter, end - 1, end);
+            *pos_iter = std::move(value);
+            ++_size;
+            return pos_iter;
+        }
+
+        iterator insert(const_iterator pos, const_reference value) {
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, value_type&& value) {
+            return emplace(pos, std::move(value));
+        }
+
+        iterator insert(const_iterator pos, size_type count, const_reference value) {
+            if (count == 0) {
+                return pos.base();
+            }
+
+            value_type clone{ value };
+            difference_type offset{ pos - begin() };
+            if (capacity() - size() < count) {
+                _grow(size() + count);
+            }
+
+            iterator begin{ this->begin() }, end{ this->end() }, pos_iter{ begin + offset }, new_pos{ pos_iter + count };
+            if (new_pos <= end) {
+                iterator middle{ end - count };
+                std::ranges::uninitialized_move(middle, end, end, std::unreachable_sentinel);
+                std::ranges::move_backward(pos_iter, middle, end);
+                std::ranges::fill(pos_iter, new_pos, clone);
+            }
+            else {
+                std::ranges::uninitialized_move(pos_iter, end, new_pos, std::unreachable_sentinel);
+                std::ranges::fill(pos_iter, end, clone);
+                std::ranges::uninitialized_fill(end, new_pos, clone);
+            }
+            _size += count;
+            return pos_iter;
+        }
+
+        template <std::input_iterator It>
+        iterator insert(const_iterator pos, It first, It last) {
+            return insert_range(pos, std::ranges::subrange(first, last));
+        }
+
+        iterator insert(const_iterator pos, std::initializer_list<value_type> list) {
+            return insert_range(pos, list);
+        }
+
+        template <std::ranges::input_range R>
+        iterator insert_range(const_iterator pos, R&& range) {
+            if constexpr (!std::ranges::forward_range<R> && !std::ranges::sized_range<R>) {
+                difference_type pos_offset{ pos - begin() }, pos_end_offset{ static_cast<difference_type>(size()) };
+                std::ranges::copy(range, std::back_inserter(*this));
+
+                iterator begin{ this->begin() }, end{ this->end() }, pos_iter{ begin + pos_offset }, pos_end{ begin + pos_end_offset };
+                std::ranges::rotate(pos_iter, pos_end, end);
+                return pos_iter;
+            }
+            else {
+                auto count{ static_cast<size_type>(std::ranges::distance(range)) };
+                if (count == 0) {
+                    return pos.base();
+                }
+
+                difference_type offset{ pos - begin() };
+                if (capacity() - size() < count) {
+                    _grow(size() + count);
+                }
+
+                auto first{ std::ranges::begin(range) };
+                iterator begin{ this->begin() }, end{ this->end() }, pos_iter{ begin + offset }, new_pos{ pos_iter + count };
+                if (new_pos <= end) {
+                    iterator middle{ end - count };
+                    std::ranges::uninitialized_move(middle, end, end, std::unreachable_sentinel);
+                    std::ranges::move_backward(pos_iter, middle, end);
+                    std::ranges::copy_n(first, count, pos_iter);
+                }
+                else {
+                    std::ranges::uninitialized_move(pos_iter, end, new_pos, std::unreachable_sentinel);
+                    auto middle{ std::ranges::copy_n(first, end - pos_iter, pos_iter).in };
+                    std::ranges::uninitialized_copy_n(middle, count - (end - pos_iter), end, std::unreachable_sentinel);
+                }
+                _size += count;
+                return pos_iter;
+            }
+        }
+
+        template <std::ranges::input_range R>
+        void append_range(R&& range) {
+            insert_range(end(), std::forward<R>(range));
+        }
+
+        iterator erase(const_iterator pos) {
+            assert(pos != end());
+            iterator pos_iter{ pos.base() };
+            std::ranges::move(std::ranges::next(pos_iter), end(), pos_iter);
+            pop_back();
+            return pos_iter;
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            iterator first_iter{ first.base() }, last_iter{ last.base() };
+            if (first_iter == last_iter) {
+                return first_iter;
+            }
+
+            iterator begin{ this->begin() }, end{ this->end() }, new_end{ std::ranges::move(last_iter, end, first_iter).out };
+            std::ranges::destroy(new_end, end);
+            _size = new_end - begin;
+            return first_iter;
+        }
+
+        void swap(Deque& other) noexcept {
+            std::ranges::swap(_data, other._data);
+            std::ranges::swap(_first, other._first);
+            std::ranges::swap(_size, other._size);
+        }
+
+        friend void swap(Deque& left, Deque& right) noexcept {
+            left.swap(right);
+        }
+
+        void clear() {
+            iterator begin{ this->begin() }, end{ this->end() };
+            if (!end._wrapped) {
+                std::ranges::destroy(begin._ptr, end._ptr);
+            }
+            else {
+                std::ranges::destroy(begin._ptr, _data.end());
+                std::ranges::destroy(_data.begin(), end._ptr);
+            }
+            _size = 0;
+        }
+
+        friend bool operator==(const Deque& left, const Deque& right) {
+            return std::ranges::equal(left, right);
+        }
+
+        friend auto operator<=>(const Deque& left, const Deque& right) {
+            return std::lexicographical_compare_three_way(left.begin(), left.end(), right.begin(), right.end());
+        }
+    };
+
+    template <class It>
+    Deque(It, It) -> Deque<std::iter_value_t<It>>;
+
+    template <class It, class Alloc>
+    Deque(It, It, Alloc) -> Deque<std::iter_value_t<It>, Alloc>;
+
+    template <std::ranges::input_range R>
+    Deque(std::from_range_t, R&&) -> Deque<std::ranges::range_value_t<R>>;
+
+    template <std::ranges::input_range R, class Alloc>
+    Deque(std::from_range_t, R&&, Alloc) -> Deque<std::ranges::range_value_t<R>, Alloc>;
+
+    template <class T, class Alloc>
+    struct is_trivially_relocatable<Deque<T, Alloc>> : is_trivially_relocatable<Alloc> {};
+
+    export template <class T, class Alloc = std::allocator<T>>
+    class SegmentedDeque {
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+    private:
+        using Traits = std::allocator_traits<allocator_type>;
+        using MapAlloc = Traits::template rebind_alloc<pointer>;
+
+        static constexpr size_type _block_size{ std::bit_floor(std::ranges::max(size_type{ 16 }, 4096 / sizeof(value_type))) };
+
+    public:
+        class iterator {
+            friend SegmentedDeque;
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = value_type*;
+            using reference = value_type&;
+
+        private:
+            static constexpr difference_type _block_size{ SegmentedDeque::_block_size };
+
+            SegmentedDeque::pointer* _node{};
+            size_type _offset{};
+
+            iterator(SegmentedDeque::pointer* node, size_type offset) :
+                _node{ node },
+                _offset{ offset } {}
+
+        public:
+            iterator() = default;
+
+            reference operator*() const {
+                return (*_node)[_offset];
+            }
+
+            pointer operator->() const {
+                return *_node + _offset;
+            }
+
+            reference operator[](difference_type index) const {
+                return *(*this + index);
+            }
+
+            friend bool operator==(iterator left, iterator right) {
+                return left._node == right._node && left._offset == right._offset;
+            }
+
+            friend std::strong_ordering operator<=>(iterator left, iterator right) {
+                if (auto cmp{ left._node <=> right._node }; cmp != 0) {
+                    return cmp;
+                }
+                return left._offset <=> right._offset;
+            }
+
+            iterator& operator+=(difference_type diff) {
+                difference_type offset{ static_cast<difference_type>(_offset) + diff };
+                difference_type node_diff{ offset >= 0 ? offset / _block_size : (offset + 1) / _block_size - 1 };
+                _node += node_diff;
+                _offset = static_cast<size_type>(offset - node_diff * _block_size);
+                return *this;
+            }
+
+            iterator& operator-=(difference_type diff) {
+                return *this += -diff;
+            }
+
+            friend iterator operator+(iterator iter, difference_type diff) {
+                return iter += diff;
+            }
+
+            friend iterator operator+(difference_type diff, iterator iter) {
+                return iter += diff;
+            }
+
+            friend iterator operator-(iterator iter, difference_type diff) {
+                return iter -= diff;
+            }
+
+            friend difference_type operator-(iterator left, iterator right) {
+                return (left._node - right._node) * _block_size + static_cast<difference_type>(left._offset) - static_cast<difference_type>(right._offset);
+            }
+
+            friend auto segments(iterator first, iterator last) {
+                return std::views::iota(first._node, last._node + (last._offset != 0)) | std::views::transform([first, last](SegmentedDeque::pointer* node) {
+                    SegmentedDeque::pointer block{ *node };
+                    return std::span{ node == first._node ? block + first._offset : block, node == last._node ? block + last._offset : block + _block_size };
+                });
+            }
+
+            iterator& operator++() {
+                if (++_offset == _block_size) {
+                    ++_node;
+                    _offset = 0;
+                }
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator temp{ *this };
+                ++*this;
+                return temp;
+            }
+
+            iterator& operator--() {
+                if (_offset == 0) {
+                    --_node;
+                    _offset = _block_size;
+                }
+                --_offset;
+                return *this;
+            }
+
+            iterator operator--(int) {
+                iterator temp{ *this };
+                --*this;
+                return temp;
+            }
+        };
+
+        using const_iterator = std::const_iterator<iterator>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    private:
+#ifdef _MSC_VER
+        [[msvc::no_unique_address]]
+#else
+        [[no_unique_address]]
+#endif
+        allocator_type _alloc;
+        Storage<pointer, MapAlloc> _map{ MapAlloc(_alloc) };
+        size_type _first{};
         size_type _size{};
 
-        void _grow(size_type new_capacity) {
-            size_type size{ this->size() };
-            Storage<value_type> new_data{ std::ranges::max(new_capacity, capacity() + (capacity() >> 1)) };
-            std::ranges::uninitialized_move(*this, new_data);
-            clear();
+        iterator _iterator(size_type index) const {
+            return { const_cast<pointer*>(_map.begin()) + index / _block_size, index % _block_size };
+        }
 
-            _data = std::move(new_data);
-            _size = size;
+        pointer _slot(size_type index) {
+            pointer& block{ _map.begin()[index / _block_size] };
+            if (block == nullptr) {
+                block = Traits::allocate(_alloc, _block_size);
+            }
+            return block + index % _block_size;
+        }
+
+        void _reserve_map() {
+            size_type map_size{ _map.size() };
+            size_type first_block{ _first / _block_size };
+            size_type used{ (_first + _size + _block_size - 1) / _block_size - first_block };
+            size_type new_map_size{ map_size >= (used + 1) * 2 ? map_size : std::ranges::max(map_size * 2, size_type{ 4 }) };
+            size_type new_first_block{ (new_map_size - used) / 2 };
+
+            // blocks keep their addresses, only the pointers to them are rearranged
+            Storage<pointer, MapAlloc> new_map{ new_map_size, _map.get_allocator() };
+            std::ranges::uninitialized_fill(new_map, nullptr);
+            for (size_type i{}; i != map_size; ++i) {
+                new_map.begin()[(new_first_block + i) % new_map_size] = _map.begin()[(first_block + i) % map_size];
+            }
+
+            _map = std::move(new_map);
+            _first = new_first_block * _block_size + _first % _block_size;
         }
 
         template <class... Args>
             requires (sizeof...(Args) <= 1)
         void _resize(size_type new_size, const Args&... args) {
-            if (new_size > capacity()) {
-                _grow(new_size);
+            while (size() > new_size) {
+                pop_back();
             }
-
-            iterator new_end{ begin() + new_size };
-            if (new_size <= size()) {
-                std::ranges::destroy(new_end, end());
-            }
-            else if constexpr (sizeof...(Args) == 0) {
-                std::ranges::uninitialized_value_construct(end(), new_end);
+            while (size() < new_size) {
+                emplace_back(args...);
             }
-            else {
-                std::ranges::uninitialized_fill(end(), new_end, args...);
-            }
-            _size = new_size;
         }
 
     public:
-        Vector() = default;
+        SegmentedDeque() = default;
 
-        explicit Vector(size_type size) :
-            _data{ size },
-            _size{ size } {
+        explicit SegmentedDeque(const allocator_type& alloc) :
+            _alloc{ alloc } {}
 
-            std::ranges::uninitialized_value_construct(*this);
+        explicit SegmentedDeque(size_type size, const allocator_type& alloc = allocator_type()) :
+            SegmentedDeque(alloc) {
+
+            this->_resize(size);
         }
 
-        Vector(size_type size, const_reference value) :
-            _data{ size },
-            _size{ size } {
+        SegmentedDeque(size_type size, const_reference value, const allocator_type& alloc = allocator_type()) :
+            SegmentedDeque(alloc) {
 
-            std::ranges::uninitialized_fill(*this, value);
+            this->_resize(size, value);
         }
 
         template <std::input_iterator It>
-        Vector(It first, It last) {
+        SegmentedDeque(It first, It last, const allocator_type& alloc = allocator_type()) :
+            SegmentedDeque(alloc) {
+
             std::ranges::copy(first, last, std::back_inserter(*this));
         }
 
-        Vector(const Vector& other) :
-            _data{ other.size() },
-            _size{ other.size() } {
+        SegmentedDeque(const SegmentedDeque& other) :
+            SegmentedDeque(other, Traits::select_on_container_copy_construction(other.get_allocator())) {}
 
-            std::ranges::uninitialized_copy(other, *this);
-        }
+        SegmentedDeque(const SegmentedDeque& other, const allocator_type& alloc) :
+            SegmentedDeque(other.begin(), other.end(), alloc) {}
+
+        SegmentedDeque(SegmentedDeque&& other) noexcept :
+            _alloc{ other._alloc } {
 
-        Vector(Vector&& other) noexcept {
             this->swap(other);
         }
 
-        Vector(std::initializer_list<value_type> list) :
-            _data{ list.size() },
-            _size{ list.size() } {
-
-            std::ranges::uninitialized_copy(list, *this);
-        }
+        SegmentedDeque(std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type()) :
+            SegmentedDeque(list.begin(), list.end(), alloc) {}
 
-        ~Vector() {
+        ~SegmentedDeque() {
             clear();
+            for (pointer block : _map) {
+                if (block != nullptr) {
+                    Traits::deallocate(_alloc, block, _block_size);
+                }
+            }
         }
 
-        Vector& operator=(const Vector& other) {
-            Vector temp(other);
+        SegmentedDeque& operator=(const SegmentedDeque& other) {
+            SegmentedDeque temp(other, get_allocator());
             this->swap(temp);
             return *this;
         }
 
-        Vector& operator=(Vector&& other) noexcept {
-            this->swap(other);
+        SegmentedDeque& operator=(SegmentedDeque&& other) noexcept(Traits::is_always_equal::value) {
+            if (get_allocator() == other.get_allocator()) {
+                this->swap(other);
+            }
+            else {
+                SegmentedDeque temp(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()), get_allocator());
+                this->swap(temp);
+            }
             return *this;
         }
 
-        Vector& operator=(std::initializer_list<value_type> list) {
-            Vector temp(list);
+        SegmentedDeque& operator=(std::initializer_list<value_type> list) {
+            SegmentedDeque temp(list, get_allocator());
             this->swap(temp);
             return *this;
         }
 
+        allocator_type get_allocator() const {
+            return _alloc;
+        }
+
         iterator begin() {
-            return _data.begin();
+            return _iterator(_first);
         }
 
         const_iterator begin() const {
-            return _data.begin();
+            return _iterator(_first);
         }
 
         iterator end() {
-            return _data.begin() + _size;
+            return _iterator(_first + _size);
         }
 
         const_iterator end() const {
-            return _data.begin() + _size;
+            return _iterator(_first + _size);
         }
 
         reverse_iterator rbegin() {
@@ -251,8 +2268,14 @@ namespace plastic {
             return static_cast<size_type>(-1) / sizeof(value_type);
         }
 
-        size_type capacity() const {
-            return _data.size();
+        MemoryStats memory_stats() const {
+            size_type blocks{ static_cast<size_type>(std::ranges::count_if(_map, [](pointer block) { return block != nullptr; })) };
+            return {
+                .elements = _size,
+                .allocations = (_map.size() != 0) + blocks,
+                .bytes_allocated = _map.size() * sizeof(pointer) + blocks * _block_size * sizeof(value_type),
+                .bytes_used = _size * sizeof(value_type)
+            };
         }
 
         void resize(size_type new_size) {
@@ -263,20 +2286,14 @@ namespace plastic {
             this->_resize(new_size, value_type{ value });
         }
 
-        void reserve(size_type new_capacity) {
-            if (new_capacity > capacity()) {
-                _grow(new_capacity);
-            }
-        }
-
         reference operator[](size_type index) {
             assert(index < size());
-            return begin()[index];
+            return *_iterator(_first + index);
         }
 
         const_reference operator[](size_type index) const {
             assert(index < size());
-            return begin()[index];
+            return *_iterator(_first + index);
         }
 
         reference front() {
@@ -291,83 +2308,102 @@ namespace plastic {
 
         reference back() {
             assert(!empty());
-            return end()[-1];
+            return *_iterator(_first + _size - 1);
         }
 
         const_reference back() const {
             assert(!empty());
-            return end()[-1];
+            return *_iterator(_first + _size - 1);
         }
 
-        pointer data() {
-            return begin();
+        template <class... Args>
+        reference emplace_front(Args&&... args) {
+            if (_first == 0) {
+                _reserve_map();
+            }
+
+            pointer ptr{ _slot(_first - 1) };
+            std::ranges::construct_at(ptr, std::forward<Args>(args)...);
+            --_first;
+            ++_size;
+            return *ptr;
         }
 
-        const_pointer data() const {
-            return begin();
+        void push_front(const_reference value) {
+            emplace_front(value);
         }
 
-        void push_back(const_reference value) {
-            value_type clone{ value };
-            if (size() == capacity()) {
-                _grow(size() + 1);
+        void push_front(value_type&& value) {
+            emplace_front(std::move(value));
+        }
+
+        void pop_front() {
+            assert(!empty());
+            std::ranges::destroy_at(std::addressof(front()));
+            ++_first;
+            --_size;
+        }
+
+        template <class... Args>
+        reference emplace_back(Args&&... args) {
+            if (_first + _size == _map.size() * _block_size) {
+                _reserve_map();
             }
 
-            std::ranges::construct_at(end(), std::move(clone));
+            pointer ptr{ _slot(_first + _size) };
+            std::ranges::construct_at(ptr, std::forward<Args>(args)...);
             ++_size;
+            return *ptr;
+        }
+
+        void push_back(const_reference value) {
+            emplace_back(value);
+        }
+
+        void push_back(value_type&& value) {
+            emplace_back(std::move(value));
         }
 
         void pop_back() {
             assert(!empty());
+            std::ranges::destroy_at(std::addressof(back()));
             --_size;
-            std::ranges::destroy_at(end());
         }
 
-        iterator insert(const_iterator pos, const_reference value) {
-            value_type clone{ value };
+        template <class... Args>
+        iterator emplace(const_iterator pos, Args&&... args) {
             difference_type offset{ pos - begin() };
-            if (size() == capacity()) {
-                _grow(size() + 1);
-            }
-
-            iterator pos_iter{ begin() + offset };
-            if (pos_iter == end()) {
-                std::ranges::construct_at(end(), std::move(clone));
+            if (static_cast<size_type>(offset) < size() / 2) {
+                emplace_front(std::forward<Args>(args)...);
+                iterator begin{ this->begin() };
+                std::ranges::rotate(begin, begin + 1, begin + offset + 1);
             }
             else {
-                std::ranges::construct_at(end(), std::move(back()));
-                std::ranges::move_backward(pos_iter, end() - 1, end());
-                *pos_iter = std::move(clone);
+                emplace_back(std::forward<Args>(args)...);
+                iterator end{ this->end() };
+                std::ranges::rotate(begin() + offset, end - 1, end);
             }
-            ++_size;
-            return pos_iter;
+            return begin() + offset;
         }
 
-        iterator insert(const_iterator pos, size_type count, const_reference value) {
-            if (count == 0) {
-                return const_cast<iterator>(pos);
-            }
+        iterator insert(const_iterator pos, const_reference value) {
+            return emplace(pos, value);
+        }
 
-            value_type clone{ value };
+        iterator insert(const_iterator pos, value_type&& value) {
+            return emplace(pos, std::move(value));
+        }
+
+        iterator insert(const_iterator pos, size_type count, const_reference value) {
             difference_type offset{ pos - begin() };
-            if (capacity() - size() < count) {
-                _grow(size() + count);
+            value_type clone{ value };
+            for (size_type i{}; i != count; ++i) {
+                emplace_back(clone);
             }
 
-            iterator pos_iter{ begin() + offset }, new_pos{ pos_iter + count };
-            if (new_pos <= end()) {
-                iterator middle{ end() - count };
-                std::ranges::uninitialized_move(middle, end(), end(), std::unreachable_sentinel);
-                std::ranges::move_backward(pos_iter, middle, end());
-                std::ranges::fill(pos_iter, new_pos, clone);
-            }
-            else {
-                std::ranges::uninitialized_move(pos_iter, end(), new_pos, std::unreachable_sentinel);
-                std::ranges::fill(pos_iter, end(), clone);
-                std::ranges::uninitialized_fill(end(), new_pos, clone);
-            }
-            _size += count;
-            return pos_iter;
+            iterator begin{ this->begin() }, end{ this->end() };
+            std::ranges::rotate(begin + offset, end - count, end);
+            return begin + offset;
         }
 
         template <std::input_iterator It>
@@ -375,88 +2411,78 @@ namespace plastic {
             difference_type pos_offset{ pos - begin() }, pos_end_offset{ static_cast<difference_type>(size()) };
             std::ranges::copy(first, last, std::back_inserter(*this));
 
-            iterator pos_iter{ begin() + pos_offset }, pos_end{ begin() + pos_end_offset };
-            std::ranges::rotate(pos_iter, pos_end, end());
-            return pos_iter;
+            iterator begin{ this->begin() };
+            std::ranges::rotate(begin + pos_offset, begin + pos_end_offset, end());
+            return begin + pos_offset;
         }
 
         iterator insert(const_iterator pos, std::initializer_list<value_type> list) {
-            if (list.empty()) {
-                return const_cast<iterator>(pos);
-            }
-
-            difference_type offset{ pos - begin() };
-            if (capacity() - size() < list.size()) {
-                _grow(size() + list.size());
-            }
-
-            iterator pos_iter{ begin() + offset }, new_pos{ pos_iter + list.size() };
-            if (new_pos <= end()) {
-                iterator middle{ end() - list.size() };
-                std::ranges::uninitialized_move(middle, end(), end(), std::unreachable_sentinel);
-                std::ranges::move_backward(pos_iter, middle, end());
-                std::ranges::move(list, pos_iter);
-            }
-            else {
-                auto middle{ list.begin() + (end() - pos_iter) };
-                std::ranges::uninitialized_move(pos_iter, end(), new_pos, std::unreachable_sentinel);
-                std::ranges::copy(list.begin(), middle, pos_iter);
-                std::ranges::uninitialized_copy(middle, list.end(), end(), std::unreachable_sentinel);
-            }
-            _size += list.size();
-            return pos_iter;
+            return this->insert(pos, list.begin(), list.end());
         }
 
         iterator erase(const_iterator pos) {
             assert(pos != end());
-            auto pos_iter{ const_cast<iterator>(pos) };
-            std::ranges::move(pos_iter + 1, end(), pos_iter);
-            pop_back();
-            return pos_iter;
+            return this->erase(pos, std::ranges::next(pos));
         }
 
         iterator erase(const_iterator first, const_iterator last) {
-            auto first_iter{ const_cast<iterator>(first) }, last_iter{ const_cast<iterator>(last) };
-            if (first_iter == last_iter) {
-                return first_iter;
+            iterator begin{ this->begin() }, end{ this->end() }, first_iter{ first.base() }, last_iter{ last.base() };
+            difference_type offset{ first_iter - begin }, count{ last_iter - first_iter };
+            if (offset < end - last_iter) {
+                std::ranges::destroy(begin, std::ranges::move_backward(begin, first_iter, last_iter).out);
+                _first += count;
             }
-
-            iterator new_end{ std::ranges::move(last_iter, end(), first_iter).out };
-            std::ranges::destroy(new_end, end());
-            _size = new_end - begin();
-            return first_iter;
+            else {
+                std::ranges::destroy(std::ranges::move(last_iter, end, first_iter).out, end);
+            }
+            _size -= count;
+            return this->begin() + offset;
         }
 
-        void swap(Vector& other) noexcept {
-            std::ranges::swap(_data, other._data);
+        void swap(SegmentedDeque& other) noexcept {
+            if constexpr (Traits::propagate_on_container_swap::value) {
+                std::ranges::swap(_alloc, other._alloc);
+            }
+            else {
+                assert(_alloc == other._alloc);
+            }
+            std::ranges::swap(_map, other._map);
+            std::ranges::swap(_first, other._first);
             std::ranges::swap(_size, other._size);
         }
 
-        friend void swap(Vector& left, Vector& right) noexcept {
+        friend void swap(SegmentedDeque& left, SegmentedDeque& right) noexcept {
             left.swap(right);
         }
 
         void clear() {
-            std::ranges::destroy(*this);
+            std::ranges::destroy(begin(), end());
             _size = 0;
         }
 
-        friend bool operator==(const Vector& left, const Vector& right) {
+        friend bool operator==(const SegmentedDeque& left, const SegmentedDeque& right) {
             return std::ranges::equal(left, right);
         }
 
-        friend auto operator<=>(const Vector& left, const Vector& right) {
+        friend auto operator<=>(const SegmentedDeque& left, const SegmentedDeque& right) {
             return std::lexicographical_compare_three_way(left.begin(), left.end(), right.begin(), right.end());
         }
     };
 
     template <class It>
-    Vector(It, It) -> Vector<std::iter_value_t<It>>;
+    SegmentedDeque(It, It) -> SegmentedDeque<std::iter_value_t<It>>;
 
-    export template <class T>
-    class Deque {
+    template <class It, class Alloc>
+    SegmentedDeque(It, It, Alloc) -> SegmentedDeque<std::iter_value_t<It>, Alloc>;
+
+    template <class T, class Alloc>
+    struct is_trivially_relocatable<SegmentedDeque<T, Alloc>> : is_trivially_relocatable<Alloc> {};
+
+    export template <class T, class Alloc = std::allocator<T>>
+    class List {
     public:
         using value_type = T;
+        using allocator_type = Alloc;
         using pointer = value_type*;
         using const_pointer = const value_type*;
         using reference = value_type&;
@@ -464,95 +2490,59 @@ namespace plastic {
         using size_type = std::size_t;
         using difference_type = std::ptrdiff_t;
 
+    private:
+        struct NodeBase {
+            NodeBase* prev{ this };
+            NodeBase* next{ this };
+        };
+
+        struct Node : NodeBase {
+            value_type value;
+
+            template <class... Args>
+            Node(NodeBase* prev, NodeBase* next, Args&&... args) :
+                NodeBase{ prev, next },
+                value(std::forward<Args>(args)...) {}
+        };
+
+        using NodeAlloc = std::allocator_traits<allocator_type>::template rebind_alloc<Node>;
+        using HeadAlloc = std::allocator_traits<allocator_type>::template rebind_alloc<NodeBase>;
+        using HeadTraits = std::allocator_traits<HeadAlloc>;
+
+    public:
         class iterator {
-            friend Deque;
+            friend List;
 
         public:
-            using iterator_category = std::random_access_iterator_tag;
+            using iterator_category = std::bidirectional_iterator_tag;
             using value_type = value_type;
             using difference_type = std::ptrdiff_t;
             using pointer = value_type*;
             using reference = value_type&;
 
         private:
-            Deque* _cont{};
-            pointer _ptr{};
-            bool _wrapped{};
-
-            iterator(Deque* cont) :
-                _cont{ cont },
-                _ptr{ cont->_data.begin() + cont->_first },
-                _wrapped{ cont->capacity() == 0 } {}
+            NodeBase* _ptr{};
 
-            difference_type _offset() const {
-                difference_type diff{ _ptr - _cont->_data.begin() - static_cast<difference_type>(_cont->_first) };
-                return _wrapped ? diff + _cont->capacity() : diff;
-            }
+            iterator(NodeBase* ptr) :
+                _ptr{ ptr } {}
 
         public:
             iterator() = default;
 
             reference operator*() const {
-                return *_ptr;
+                return static_cast<Node*>(_ptr)->value;
             }
 
             pointer operator->() const {
-                return _ptr;
-            }
-
-            reference operator[](difference_type index) const {
-                return *(*this + index);
+                return std::addressof(static_cast<Node*>(_ptr)->value);
             }
 
             friend bool operator==(iterator left, iterator right) {
-                return left._ptr == right._ptr && left._wrapped == right._wrapped;
-            }
-
-            friend auto operator<=>(iterator left, iterator right) {
-                return left._offset() <=> right._offset();
-            }
-
-            iterator& operator+=(difference_type diff) {
-                if (_cont->_data.end() - _ptr <= diff) {
-                    _ptr += diff - _cont->capacity();
-                    _wrapped = true;
-                }
-                else if (_ptr - _cont->_data.begin() < -diff) {
-                    _ptr += diff + _cont->capacity();
-                    _wrapped = false;
-                }
-                else {
-                    _ptr += diff;
-                }
-                return *this;
-            }
-
-            iterator& operator-=(difference_type diff) {
-                return *this += -diff;
-            }
-
-            friend iterator operator+(iterator iter, difference_type diff) {
-                return iter += diff;
-            }
-
-            friend iterator operator+(difference_type diff, iterator iter) {
-                return iter += diff;
-            }
-
-            friend iterator operator-(iterator iter, difference_type diff) {
-                return iter -= diff;
-            }
-
-            friend difference_type operator-(iterator left, iterator right) {
-                return left._offset() - right._offset();
+                return left._ptr == right._ptr;
             }
 
             iterator& operator++() {
-                ++_ptr;
-                if (_ptr == _cont->_data.end()) {
-                    _ptr = _cont->_data.begin();
-                    _wrapped = true;
-                }
+                _ptr = _ptr->next;
                 return *this;
             }
 
@@ -563,11 +2553,7 @@ namespace plastic {
             }
 
             iterator& operator--() {
-                if (_ptr == _cont->_data.begin()) {
-                    _ptr = _cont->_data.end();
-                    _wrapped = false;
-                }
-                --_ptr;
+                _ptr = _ptr->prev;
                 return *this;
             }
 
@@ -583,148 +2569,195 @@ namespace plastic {
         using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
     private:
-        Storage<value_type> _data;
-        size_type _first{};
+        NodePool<Node, NodeAlloc> _pool;
+        NodeBase* _head{ _new_head() };
         size_type _size{};
 
-        void _grow(size_type new_capacity) {
-            size_type size{ this->size() };
-            iterator begin{ this->begin() }, end{ this->end() };
-            Storage<value_type> new_data{ std::ranges::max(new_capacity, capacity() + (capacity() >> 1)) };
-            if (!end._wrapped) {
-                std::ranges::uninitialized_move(begin._ptr, end._ptr, new_data.begin(), std::unreachable_sentinel);
+        NodeBase* _new_head() {
+            HeadAlloc alloc{ _pool.get_allocator() };
+            NodeBase* head{ HeadTraits::allocate(alloc, 1) };
+            HeadTraits::construct(alloc, head);
+            return head;
+        }
+
+        void _delete_head() {
+            HeadAlloc alloc{ _pool.get_allocator() };
+            HeadTraits::destroy(alloc, _head);
+            HeadTraits::deallocate(alloc, _head, 1);
+        }
+
+        template <class... Args>
+        Node* _new_node(NodeBase* prev, NodeBase* next, Args&&... args) {
+            Node* node{ _pool.allocate() };
+            try {
+                std::construct_at(node, prev, next, std::forward<Args>(args)...);
             }
-            else {
-                pointer middle{ std::ranges::uninitialized_move(begin._ptr, _data.end(), new_data.begin(), std::unreachable_sentinel).out };
-                std::ranges::uninitialized_move(_data.begin(), end._ptr, middle, std::unreachable_sentinel);
+            catch (...) {
+                _pool.deallocate(node);
+                throw;
             }
-            clear();
+            return node;
+        }
 
-            _data = std::move(new_data);
-            _first = 0;
-            _size = size;
+        void _delete_node(NodeBase* node) {
+            auto ptr{ static_cast<Node*>(node) };
+            std::destroy_at(ptr);
+            _pool.deallocate(ptr);
         }
 
         template <class... Args>
             requires (sizeof...(Args) <= 1)
-        void _resize(size_type new_size, const Args&... args) {
-            if (new_size > capacity()) {
-                _grow(new_size);
+        NodeBase* _insert(NodeBase* pos, size_type count, const Args&... args) {
+            NodeBase *prev{ pos->prev }, *cur{ prev };
+            _pool.reserve(count);
+            _size += count;
+            while (count-- != 0) {
+                cur = cur->next = _new_node(cur, cur->next, args...);
             }
+            cur->next->prev = cur;
+            return prev->next;
+        }
 
-            iterator begin{ this->begin() }, end{ this->end() }, new_end{ begin + new_size };
-            if (new_size <= size()) {
-                if (new_end._wrapped == end._wrapped) {
-                    std::ranges::destroy(new_end._ptr, end._ptr);
+        static void _transfer(NodeBase* pos, NodeBase* first, NodeBase* last) {
+            if (pos == first || pos == last) {
+                return;
+            }
+
+            NodeBase* back{ last->prev };
+            first->prev->next = last;
+            last->prev = first->prev;
+            first->prev = pos->prev;
+            back->next = pos;
+            pos->prev->next = first;
+            pos->prev = back;
+        }
+
+        // merges two null-terminated runs through next only, taking from left on ties
+        template <class Pr>
+        static NodeBase* _merge(NodeBase* left, NodeBase* right, Pr& pred) {
+            NodeBase result, *tail{ &result };
+            while (left != nullptr && right != nullptr) {
+                if (pred(static_cast<Node*>(right)->value, static_cast<Node*>(left)->value)) {
+                    tail = tail->next = std::exchange(right, right->next);
                 }
                 else {
-                    std::ranges::destroy(new_end._ptr, _data.end());
-                    std::ranges::destroy(_data.begin(), end._ptr);
+                    tail = tail->next = std::exchange(left, left->next);
                 }
             }
-            else if constexpr (sizeof...(Args) == 0) {
-                if (new_end._wrapped == end._wrapped) {
-                    std::ranges::uninitialized_value_construct(end._ptr, new_end._ptr);
-                }
-                else {
-                    std::ranges::uninitialized_value_construct(end._ptr, _data.end());
-                    std::ranges::uninitialized_value_construct(_data.begin(), new_end._ptr);
+            tail->next = left != nullptr ? left : right;
+            return result.next;
+        }
+
+        // restores prev and the circular links after _head->next was set to a null-terminated chain
+        void _relink() {
+            NodeBase* i{ _head };
+            while (i->next != nullptr) {
+                i->next->prev = i;
+                i = i->next;
+            }
+            i->next = _head;
+            _head->prev = i;
+        }
+
+        template <class... Args>
+            requires (sizeof...(Args) <= 1)
+        void _resize(size_type new_size, const Args&... args) {
+            if (new_size <= size()) {
+                while (size() != new_size) {
+                    pop_back();
                 }
             }
             else {
-                if (new_end._wrapped == end._wrapped) {
-                    std::ranges::uninitialized_fill(end._ptr, new_end._ptr, args...);
-                }
-                else {
-                    std::ranges::uninitialized_fill(end._ptr, _data.end(), args...);
-                    std::ranges::uninitialized_fill(_data.begin(), new_end._ptr, args...);
-                }
+                this->_insert(_head, new_size - size(), args...);
             }
-            _size = new_size;
         }
 
     public:
-        Deque() = default;
+        List() = default;
 
-        explicit Deque(size_type size) :
-            _data{ size },
-            _size{ size } {
+        explicit List(const allocator_type& alloc) :
+            _pool{ NodeAlloc(alloc) } {}
 
-            std::ranges::uninitialized_value_construct(_data);
+        explicit List(size_type size, const allocator_type& alloc = allocator_type()) :
+            _pool{ NodeAlloc(alloc) } {
+
+            this->_insert(_head, size);
         }
 
-        Deque(size_type size, const_reference value) :
-            _data{ size },
-            _size{ size } {
+        List(size_type size, const_reference value, const allocator_type& alloc = allocator_type()) :
+            _pool{ NodeAlloc(alloc) } {
 
-            std::ranges::uninitialized_fill(_data, value);
+            this->insert(end(), size, value);
         }
 
         template <std::input_iterator It>
-        Deque(It first, It last) {
-            std::ranges::copy(first, last, std::back_inserter(*this));
+        List(It first, It last, const allocator_type& alloc = allocator_type()) :
+            _pool{ NodeAlloc(alloc) } {
+
+            this->insert(end(), first, last);
         }
 
-        Deque(const Deque& other) :
-            _data{ other.size() },
-            _size{ other.size() } {
+        List(const List& other) :
+            List(other, std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator())) {}
 
-            iterator begin{ other.begin().base() }, end{ other.end().base() };
-            if (!end._wrapped) {
-                std::ranges::uninitialized_copy(begin._ptr, end._ptr, _data.begin(), std::unreachable_sentinel);
-            }
-            else {
-                pointer middle{ std::ranges::uninitialized_copy(begin._ptr, other._data.end(), _data.begin(), std::unreachable_sentinel).out };
-                std::ranges::uninitialized_copy(other._data.begin(), end._ptr, middle, std::unreachable_sentinel);
-            }
-        }
+        List(const List& other, const allocator_type& alloc) :
+            List(other.begin(), other.end(), alloc) {}
+
+        List(List&& other) noexcept :
+            _pool{ other._pool.get_allocator() } {
 
-        Deque(Deque&& other) noexcept {
             this->swap(other);
         }
 
-        Deque(std::initializer_list<value_type> list) :
-            _data{ list.size() },
-            _size{ list.size() } {
-
-            std::ranges::uninitialized_copy(list, _data);
-        }
+        List(std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type()) :
+            List(list.begin(), list.end(), alloc) {}
 
-        ~Deque() {
+        ~List() {
             clear();
+            _delete_head();
         }
 
-        Deque& operator=(const Deque& other) {
-            Deque temp(other);
+        List& operator=(const List& other) {
+            List temp(other, get_allocator());
             this->swap(temp);
             return *this;
         }
 
-        Deque& operator=(Deque&& other) noexcept {
-            this->swap(other);
+        List& operator=(List&& other) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value) {
+            if (get_allocator() == other.get_allocator()) {
+                this->swap(other);
+            }
+            else {
+                List temp(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()), get_allocator());
+                this->swap(temp);
+            }
             return *this;
         }
 
-        Deque& operator=(std::initializer_list<value_type> list) {
-            Deque temp(list);
+        List& operator=(std::initializer_list<value_type> list) {
+            List temp(list, get_allocator());
             this->swap(temp);
             return *this;
         }
 
+        allocator_type get_allocator() const {
+            return allocator_type(_pool.get_allocator());
+        }
+
         iterator begin() {
-            return iterator{ this };
+            return iterator{ _head->next };
         }
 
         const_iterator begin() const {
-            return iterator{ const_cast<Deque*>(this) };
+            return iterator{ _head->next };
         }
 
         iterator end() {
-            return iterator{ this } + _size;
+            return iterator{ _head };
         }
 
         const_iterator end() const {
-            return iterator{ const_cast<Deque*>(this) } + _size;
+            return iterator{ _head };
         }
 
         reverse_iterator rbegin() {
@@ -771,8 +2804,13 @@ namespace plastic {
             return static_cast<size_type>(-1) / sizeof(value_type);
         }
 
-        size_type capacity() const {
-            return _data.size();
+        MemoryStats memory_stats() const {
+            MemoryStats stats{ _pool.memory_stats() };
+            stats.elements = stats.nodes = _size;
+            stats.allocations += 1;
+            stats.bytes_allocated += sizeof(NodeBase);
+            stats.bytes_used = _size * sizeof(value_type);
+            return stats;
         }
 
         void resize(size_type new_size) {
@@ -780,23 +2818,7 @@ namespace plastic {
         }
 
         void resize(size_type new_size, const_reference value) {
-            this->_resize(new_size, value_type{ value });
-        }
-
-        void reserve(size_type new_capacity) {
-            if (new_capacity > capacity()) {
-                _grow(new_capacity);
-            }
-        }
-
-        reference operator[](size_type index) {
-            assert(index < size());
-            return begin()[index];
-        }
-
-        const_reference operator[](size_type index) const {
-            assert(index < size());
-            return begin()[index];
+            this->_resize(new_size, value);
         }
 
         reference front() {
@@ -819,184 +2841,296 @@ namespace plastic {
             return *--end();
         }
 
+        template <class... Args>
+        reference emplace_front(Args&&... args) {
+            return *this->emplace(begin(), std::forward<Args>(args)...);
+        }
+
         void push_front(const_reference value) {
-            value_type clone{ value };
-            if (size() == capacity()) {
-                _grow(size() + 1);
-            }
+            this->emplace(begin(), value);
+        }
 
-            iterator begin{ this->begin() };
-            std::ranges::construct_at((--begin)._ptr, std::move(clone));
-            _first = begin._ptr - _data.begin();
-            ++_size;
+        void push_front(value_type&& value) {
+            this->emplace(begin(), std::move(value));
         }
 
         void pop_front() {
             assert(!empty());
-            iterator begin{ this->begin() };
-            std::ranges::destroy_at(begin++._ptr);
-            _first = begin._ptr - _data.begin();
-            --_size;
+            this->erase(begin());
+        }
+
+        template <class... Args>
+        reference emplace_back(Args&&... args) {
+            return *this->emplace(end(), std::forward<Args>(args)...);
         }
 
         void push_back(const_reference value) {
-            value_type clone{ value };
-            if (size() == capacity()) {
-                _grow(size() + 1);
-            }
+            this->emplace(end(), value);
+        }
 
-            std::ranges::construct_at(end()._ptr, std::move(clone));
-            ++_size;
+        void push_back(value_type&& value) {
+            this->emplace(end(), std::move(value));
         }
 
         void pop_back() {
             assert(!empty());
-            --_size;
-            std::ranges::destroy_at(end()._ptr);
+            this->erase(--end());
+        }
+
+        template <class... Args>
+        iterator emplace(const_iterator pos, Args&&... args) {
+            NodeBase* prev{ pos.base()._ptr->prev };
+            prev->next->next->prev = prev->next = _new_node(prev, prev->next, std::forward<Args>(args)...);
+            ++_size;
+            return prev->next;
         }
 
         iterator insert(const_iterator pos, const_reference value) {
-            value_type clone{ value };
-            difference_type offset{ pos - begin() };
-            if (size() == capacity()) {
-                _grow(size() + 1);
-            }
+            return this->emplace(pos, value);
+        }
 
-            iterator begin{ this->begin() }, end{ this->end() }, pos_iter{ begin + offset };
-            if (pos_iter == end) {
-                std::ranges::construct_at(end._ptr, std::move(clone));
-            }
-            else {
-                std::ranges::construct_at(end._ptr, std::move(back()));
-                std::ranges::move_backward(pos_iter, end - 1, end);
-                *pos_iter = std::move(clone);
-            }
-            ++_size;
-            return pos_iter;
+        iterator insert(const_iterator pos, value_type&& value) {
+            return this->emplace(pos, std::move(value));
         }
 
         iterator insert(const_iterator pos, size_type count, const_reference value) {
-            if (count == 0) {
-                return pos.base();
-            }
+            return this->_insert(pos.base()._ptr, count, value);
+        }
 
-            value_type clone{ value };
-            difference_type offset{ pos - begin() };
-            if (capacity() - size() < count) {
-                _grow(size() + count);
+        template <std::input_iterator It>
+        iterator insert(const_iterator pos, It first, It last) {
+            NodeBase *prev{ pos.base()._ptr->prev }, *cur{ prev };
+            if constexpr (std::forward_iterator<It>) {
+                _pool.reserve(static_cast<size_type>(std::ranges::distance(first, last)));
             }
-
-            iterator begin{ this->begin() }, end{ this->end() }, pos_iter{ begin + offset }, new_pos{ pos_iter + count };
-            if (new_pos <= end) {
-                iterator middle{ end - count };
-                std::ranges::uninitialized_move(middle, end, end, std::unreachable_sentinel);
-                std::ranges::move_backward(pos_iter, middle, end);
-                std::ranges::fill(pos_iter, new_pos, clone);
+            while (first != last) {
+                cur = cur->next = _new_node(cur, cur->next, *first);
+                ++first, ++_size;
             }
-            else {
-                std::ranges::uninitialized_move(pos_iter, end, new_pos, std::unreachable_sentinel);
-                std::ranges::fill(pos_iter, end, clone);
-                std::ranges::uninitialized_fill(end, new_pos, clone);
+            cur->next->prev = cur;
+            return prev->next;
+        }
+
+        iterator insert(const_iterator pos, std::initializer_list<value_type> list) {
+            return this->insert(pos, list.begin(), list.end());
+        }
+
+        iterator erase(const_iterator pos) {
+            NodeBase* prev{ pos.base()._ptr->prev };
+            _delete_node(std::exchange(prev->next, prev->next->next));
+            --_size;
+            prev->next->prev = prev;
+            return prev->next;
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            NodeBase *first_ptr{ first.base()._ptr }, *last_ptr{ last.base()._ptr };
+            first_ptr->prev->next = last_ptr;
+            last_ptr->prev = first_ptr->prev;
+            while (first_ptr != last_ptr) {
+                _delete_node(std::exchange(first_ptr, first_ptr->next));
+                --_size;
             }
-            _size += count;
-            return pos_iter;
+            return first_ptr;
         }
 
-        template <std::input_iterator It>
-        iterator insert(const_iterator pos, It first, It last) {
-            difference_type pos_offset{ pos - begin() }, pos_end_offset{ static_cast<difference_type>(size()) };
-            std::ranges::copy(first, last, std::back_inserter(*this));
+        void swap(List& other) noexcept {
+            _pool.swap(other._pool);
+            std::ranges::swap(_head, other._head);
+            std::ranges::swap(_size, other._size);
+        }
 
-            iterator begin{ this->begin() }, end{ this->end() }, pos_iter{ begin + pos_offset }, pos_end{ begin + pos_end_offset };
-            std::ranges::rotate(pos_iter, pos_end, end);
-            return pos_iter;
+        friend void swap(List& left, List& right) noexcept {
+            left.swap(right);
         }
 
-        iterator insert(const_iterator pos, std::initializer_list<value_type> list) {
-            if (list.empty()) {
-                return pos.base();
+        void clear() {
+            NodeBase* i{ _head->next };
+            while (i != _head) {
+                _delete_node(std::exchange(i, i->next));
             }
+            _head->prev = _head->next = _head;
+            _size = 0;
+            _pool.release();
+        }
 
-            difference_type offset{ pos - begin() };
-            if (capacity() - size() < list.size()) {
-                _grow(size() + list.size());
+        void splice(const_iterator pos, List& other) {
+            this->splice(pos, other, other.begin(), other.end());
+        }
+
+        void splice(const_iterator pos, List&& other) {
+            this->splice(pos, other);
+        }
+
+        void splice(const_iterator pos, List& other, const_iterator it) {
+            this->splice(pos, other, it, std::ranges::next(it));
+        }
+
+        void splice(const_iterator pos, List&& other, const_iterator it) {
+            this->splice(pos, other, it);
+        }
+
+        void splice(const_iterator pos, List& other, const_iterator first, const_iterator last) {
+            if (first == last) {
+                return;
             }
 
-            iterator begin{ this->begin() }, end{ this->end() }, pos_iter{ begin + offset }, new_pos{ pos_iter + list.size() };
-            if (new_pos <= end) {
-                iterator middle{ end - list.size() };
-                std::ranges::uninitialized_move(middle, end, end, std::unreachable_sentinel);
-                std::ranges::move_backward(pos_iter, middle, end);
-                std::ranges::move(list, pos_iter);
+            if (this != std::addressof(other)) {
+                size_type count{ static_cast<size_type>(std::ranges::distance(first, last)) };
+                _pool.share(other._pool);
+                _size += count;
+                other._size -= count;
             }
-            else {
-                auto middle{ list.begin() + (end - pos_iter) };
-                std::ranges::uninitialized_move(pos_iter, end, new_pos, std::unreachable_sentinel);
-                std::ranges::copy(list.begin(), middle, pos_iter);
-                std::ranges::uninitialized_copy(middle, list.end(), end, std::unreachable_sentinel);
+            _transfer(pos.base()._ptr, first.base()._ptr, last.base()._ptr);
+            if (other._size == 0) {
+                other._pool.release();
+            }
+        }
+
+        void splice(const_iterator pos, List&& other, const_iterator first, const_iterator last) {
+            this->splice(pos, other, first, last);
+        }
+
+        // value may be an element of the list, whose node is then erased last
+        size_type remove(const_reference value) {
+            size_type old_size{ _size };
+            NodeBase *i{ _head->next }, *aliased{};
+            while (i != _head) {
+                NodeBase* next{ i->next };
+                if (static_cast<Node*>(i)->value == value) {
+                    if (std::addressof(static_cast<Node*>(i)->value) == std::addressof(value)) {
+                        aliased = i;
+                    }
+                    else {
+                        this->erase(iterator{ i });
+                    }
+                }
+                i = next;
             }
-            _size += list.size();
-            return pos_iter;
+            if (aliased != nullptr) {
+                this->erase(iterator{ aliased });
+            }
+            return old_size - _size;
         }
 
-        iterator erase(const_iterator pos) {
-            assert(pos != end());
-            iterator pos_iter{ pos.base() };
-            std::ranges::move(std::ranges::next(pos_iter), end(), pos_iter);
-            pop_back();
-            return pos_iter;
+        template <class Pr>
+        size_type remove_if(Pr pred) {
+            size_type old_size{ _size };
+            NodeBase* i{ _head->next };
+            while (i != _head) {
+                if (pred(static_cast<Node*>(i)->value)) {
+                    i = this->erase(iterator{ i })._ptr;
+                }
+                else {
+                    i = i->next;
+                }
+            }
+            return old_size - _size;
+        }
+
+        void reverse() {
+            NodeBase* i{ _head };
+            do {
+                std::ranges::swap(i->prev, i->next);
+                i = i->prev;
+            } while (i != _head);
+        }
+
+        template <class Pr = std::equal_to<>>
+        size_type unique(Pr pred = {}) {
+            size_type old_size{ _size };
+            if (_size > 1) {
+                NodeBase *i{ _head->next }, *j{ i->next };
+                while (j != _head) {
+                    if (pred(static_cast<Node*>(i)->value, static_cast<Node*>(j)->value)) {
+                        j = this->erase(iterator{ j })._ptr;
+                    }
+                    else {
+                        i = std::exchange(j, j->next);
+                    }
+                }
+            }
+            return old_size - _size;
         }
 
-        iterator erase(const_iterator first, const_iterator last) {
-            iterator first_iter{ first.base() }, last_iter{ last.base() };
-            if (first_iter == last_iter) {
-                return first_iter;
+        template <class Pr = std::less<>>
+        void merge(List& other, Pr pred = {}) {
+            if (this == std::addressof(other) || other.empty()) {
+                return;
             }
 
-            iterator begin{ this->begin() }, end{ this->end() }, new_end{ std::ranges::move(last_iter, end, first_iter).out };
-            std::ranges::destroy(new_end, end);
-            _size = new_end - begin;
-            return first_iter;
+            _pool.share(other._pool);
+            _size += std::exchange(other._size, 0);
+            _head->prev->next = nullptr;
+            other._head->prev->next = nullptr;
+            _head->next = _merge(_head->next, std::exchange(other._head->next, other._head), pred);
+            other._head->prev = other._head;
+            other._pool.release();
+            _relink();
         }
 
-        void swap(Deque& other) noexcept {
-            std::ranges::swap(_data, other._data);
-            std::ranges::swap(_first, other._first);
-            std::ranges::swap(_size, other._size);
+        template <class Pr = std::less<>>
+        void merge(List&& other, Pr pred = {}) {
+            this->merge(other, pred);
         }
 
-        friend void swap(Deque& left, Deque& right) noexcept {
-            left.swap(right);
-        }
+        template <class Pr = std::less<>>
+        void sort(Pr pred = {}) {
+            if (_size < 2) {
+                return;
+            }
 
-        void clear() {
-            iterator begin{ this->begin() }, end{ this->end() };
-            if (!end._wrapped) {
-                std::ranges::destroy(begin._ptr, end._ptr);
+            // bottom-up merge sort, runs[k] holds a sorted run of 2^k nodes linked through next
+            NodeBase* runs[std::numeric_limits<size_type>::digits]{};
+            size_type max_rank{};
+            _head->prev->next = nullptr;
+            NodeBase* i{ _head->next };
+            while (i != nullptr) {
+                NodeBase* run{ std::exchange(i, i->next) };
+                run->next = nullptr;
+                size_type rank{};
+                for (; runs[rank] != nullptr; ++rank) {
+                    run = _merge(std::exchange(runs[rank], nullptr), run, pred);
+                }
+                runs[rank] = run;
+                max_rank = std::ranges::max(max_rank, rank);
             }
-            else {
-                std::ranges::destroy(begin._ptr, _data.end());
-                std::ranges::destroy(_data.begin(), end._ptr);
+
+            NodeBase* result{};
+            for (size_type rank{}; rank <= max_rank; ++rank) {
+                if (runs[rank] != nullptr) {
+                    result = result == nullptr ? runs[rank] : _merge(runs[rank], result, pred);
+                }
             }
-            _size = 0;
+            _head->next = result;
+            _relink();
         }
 
-        friend bool operator==(const Deque& left, const Deque& right) {
+        friend bool operator==(const List& left, const List& right) {
             return std::ranges::equal(left, right);
         }
 
-        friend auto operator<=>(const Deque& left, const Deque& right) {
+        friend auto operator<=>(const List& left, const List& right) {
             return std::lexicographical_compare_three_way(left.begin(), left.end(), right.begin(), right.end());
         }
     };
 
     template <class It>
-    Deque(It, It) -> Deque<std::iter_value_t<It>>;
+    List(It, It) -> List<std::iter_value_t<It>>;
 
-    export template <class T>
-    class List {
+    template <class It, class Alloc>
+    List(It, It, Alloc) -> List<std::iter_value_t<It>, Alloc>;
+
+    template <class T, class Alloc>
+    struct is_trivially_relocatable<List<T, Alloc>> : is_trivially_relocatable<Alloc> {};
+
+    // elements live in groups of slots that never move, so pointers stay valid until the element is erased
+    // erased slots are skipped through a jump-counting skip field and reused by later insertions
+    export template <class T, class Alloc = std::allocator<T>>
+    class Hive {
     public:
         using value_type = T;
+        using allocator_type = Alloc;
         using pointer = value_type*;
         using const_pointer = const value_type*;
         using reference = value_type&;
@@ -1005,18 +3139,59 @@ namespace plastic {
         using difference_type = std::ptrdiff_t;
 
     private:
-        struct NodeBase {
-            NodeBase* prev{ this };
-            NodeBase* next{ this };
-        };
+        using skip_type = std::uint16_t;
 
-        struct Node : NodeBase {
+        static constexpr skip_type _none{ std::numeric_limits<skip_type>::max() };
+        static constexpr size_type _min_group_size{ 8 };
+        static constexpr size_type _max_group_size{ 8192 };
+
+        // the first slot of each erased run links it into the free list of its group
+        union Slot {
             value_type value;
+
+            struct {
+                skip_type prev;
+                skip_type next;
+            } links;
+
+            Slot() {}
+
+            ~Slot() {}
+        };
+
+        using SlotAlloc = std::allocator_traits<allocator_type>::template rebind_alloc<Slot>;
+        using SkipAlloc = std::allocator_traits<allocator_type>::template rebind_alloc<skip_type>;
+
+        // skip[i] is zero for live slots, the first and last slot of an erased run both hold its length
+        struct Group {
+            Group* prev{};
+            Group* next{};
+            Group* prev_free{};
+            Group* next_free{};
+            Storage<Slot, SlotAlloc> slots;
+            Storage<skip_type, SkipAlloc> skip;
+            size_type last{};
+            size_type size{};
+            skip_type free_head{ _none };
+
+            Group(size_type capacity, const allocator_type& alloc) :
+                slots{ capacity, SlotAlloc(alloc) },
+                skip{ capacity + 1, SkipAlloc(alloc) } {
+
+                std::ranges::uninitialized_fill(skip, skip_type{});
+            }
+
+            value_type* value(size_type index) {
+                return std::addressof(slots.begin()[index].value);
+            }
         };
 
+        using GroupAlloc = std::allocator_traits<allocator_type>::template rebind_alloc<Group>;
+        using GroupTraits = std::allocator_traits<GroupAlloc>;
+
     public:
         class iterator {
-            friend List;
+            friend Hive;
 
         public:
             using iterator_category = std::bidirectional_iterator_tag;
@@ -1026,28 +3201,35 @@ namespace plastic {
             using reference = value_type&;
 
         private:
-            NodeBase* _ptr{};
+            Group* _group{};
+            size_type _index{};
 
-            iterator(NodeBase* ptr) :
-                _ptr{ ptr } {}
+            iterator(Group* group, size_type index) :
+                _group{ group },
+                _index{ index } {}
 
         public:
             iterator() = default;
 
             reference operator*() const {
-                return static_cast<Node*>(_ptr)->value;
+                return *_group->value(_index);
             }
 
             pointer operator->() const {
-                return std::addressof(static_cast<Node*>(_ptr)->value);
+                return _group->value(_index);
             }
 
             friend bool operator==(iterator left, iterator right) {
-                return left._ptr == right._ptr;
+                return left._group == right._group && left._index == right._index;
             }
 
             iterator& operator++() {
-                _ptr = _ptr->next;
+                ++_index;
+                _index += _group->skip.begin()[_index];
+                if (_index == _group->last && _group->next != nullptr) {
+                    _group = _group->next;
+                    _index = _group->skip.begin()[0];
+                }
                 return *this;
             }
 
@@ -1058,8 +3240,19 @@ namespace plastic {
             }
 
             iterator& operator--() {
-                _ptr = _ptr->prev;
-                return *this;
+                while (true) {
+                    if (_index == 0) {
+                        _group = _group->prev;
+                        _index = _group->last;
+                    }
+                    --_index;
+
+                    skip_type skip{ _group->skip.begin()[_index] };
+                    if (skip == 0) {
+                        return *this;
+                    }
+                    _index -= skip - 1;
+                }
             }
 
             iterator operator--(int) {
@@ -1074,96 +3267,167 @@ namespace plastic {
         using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
     private:
-        NodeBase* _head{ new NodeBase };
+#ifdef _MSC_VER
+        [[msvc::no_unique_address]]
+#else
+        [[no_unique_address]]
+#endif
+        GroupAlloc _alloc;
+        Group* _head{};
+        Group* _tail{};
+        Group* _free_groups{};
         size_type _size{};
 
-        template <class... Args>
-            requires (sizeof...(Args) <= 1)
-        NodeBase* _insert(NodeBase* pos, size_type count, const Args&... args) {
-            NodeBase *prev{ pos->prev }, *cur{ prev };
-            _size += count;
-            while (count-- != 0) {
-                cur = cur->next = new Node{ cur, cur->next, args... };
+        Group* _new_group() {
+            size_type capacity{ _tail == nullptr ? _min_group_size : std::ranges::min(_tail->slots.size() * 2, _max_group_size) };
+            Group* group{ GroupTraits::allocate(_alloc, 1) };
+            try {
+                GroupTraits::construct(_alloc, group, capacity, get_allocator());
             }
-            cur->next->prev = cur;
-            return prev->next;
+            catch (...) {
+                GroupTraits::deallocate(_alloc, group, 1);
+                throw;
+            }
+
+            group->prev = _tail;
+            (_tail == nullptr ? _head : _tail->next) = group;
+            _tail = group;
+            return group;
         }
 
-        template <class... Args>
-            requires (sizeof...(Args) <= 1)
-        void _resize(size_type new_size, const Args&... args) {
-            if (new_size <= size()) {
-                while (size() != new_size) {
-                    pop_back();
-                }
+        void _delete_group(Group* group) {
+            if (group->free_head != _none) {
+                _unlink_free(group);
             }
-            else {
-                this->_insert(_head, new_size - size(), args...);
+            (group->prev == nullptr ? _head : group->prev->next) = group->next;
+            (group->next == nullptr ? _tail : group->next->prev) = group->prev;
+            GroupTraits::destroy(_alloc, group);
+            GroupTraits::deallocate(_alloc, group, 1);
+        }
+
+        void _link_free(Group* group) {
+            group->prev_free = nullptr;
+            group->next_free = _free_groups;
+            if (_free_groups != nullptr) {
+                _free_groups->prev_free = group;
+            }
+            _free_groups = group;
+        }
+
+        void _unlink_free(Group* group) {
+            (group->prev_free == nullptr ? _free_groups : group->prev_free->next_free) = group->next_free;
+            if (group->next_free != nullptr) {
+                group->next_free->prev_free = group->prev_free;
+            }
+        }
+
+        static void _push_run(Group* group, size_type index) {
+            group->slots.begin()[index].links = { _none, group->free_head };
+            if (group->free_head != _none) {
+                group->slots.begin()[group->free_head].links.prev = static_cast<skip_type>(index);
             }
+            group->free_head = static_cast<skip_type>(index);
+        }
+
+        static void _pop_run(Group* group, size_type index) {
+            auto [prev, next] { group->slots.begin()[index].links };
+            (prev == _none ? group->free_head : group->slots.begin()[prev].links.next) = next;
+            if (next != _none) {
+                group->slots.begin()[next].links.prev = prev;
+            }
+        }
+
+        static void _set_run(Group* group, size_type first, size_type length) {
+            group->skip.begin()[first] = group->skip.begin()[first + length - 1] = static_cast<skip_type>(length);
         }
 
     public:
-        List() = default;
+        Hive() = default;
 
-        explicit List(size_type size) {
-            this->_insert(_head, size);
+        explicit Hive(const allocator_type& alloc) :
+            _alloc{ alloc } {}
+
+        explicit Hive(size_type size, const allocator_type& alloc = allocator_type()) :
+            _alloc{ alloc } {
+
+            while (size-- != 0) {
+                emplace();
+            }
         }
 
-        List(size_type size, const_reference value) {
-            this->insert(end(), size, value);
+        Hive(size_type size, const_reference value, const allocator_type& alloc = allocator_type()) :
+            _alloc{ alloc } {
+
+            insert(size, value);
         }
 
         template <std::input_iterator It>
-        List(It first, It last) {
-            this->insert(end(), first, last);
+        Hive(It first, It last, const allocator_type& alloc = allocator_type()) :
+            _alloc{ alloc } {
+
+            insert(first, last);
         }
 
-        List(const List& other) :
-            List(other.begin(), other.end()) {}
+        Hive(const Hive& other) :
+            Hive(other, std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator())) {}
+
+        Hive(const Hive& other, const allocator_type& alloc) :
+            Hive(other.begin(), other.end(), alloc) {}
+
+        Hive(Hive&& other) noexcept :
+            _alloc{ other._alloc } {
 
-        List(List&& other) noexcept {
             this->swap(other);
         }
 
-        List(std::initializer_list<value_type> list) :
-            List(list.begin(), list.end()) {}
+        Hive(std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type()) :
+            Hive(list.begin(), list.end(), alloc) {}
 
-        ~List() {
+        ~Hive() {
             clear();
-            delete _head;
         }
 
-        List& operator=(const List& other) {
-            List temp(other);
+        Hive& operator=(const Hive& other) {
+            Hive temp(other, get_allocator());
             this->swap(temp);
             return *this;
         }
 
-        List& operator=(List&& other) noexcept {
-            this->swap(other);
+        Hive& operator=(Hive&& other) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value) {
+            if (get_allocator() == other.get_allocator()) {
+                this->swap(other);
+            }
+            else {
+                Hive temp(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()), get_allocator());
+                this->swap(temp);
+            }
             return *this;
         }
 
-        List& operator=(std::initializer_list<value_type> list) {
-            List temp(list);
+        Hive& operator=(std::initializer_list<value_type> list) {
+            Hive temp(list, get_allocator());
             this->swap(temp);
             return *this;
         }
 
+        allocator_type get_allocator() const {
+            return allocator_type(_alloc);
+        }
+
         iterator begin() {
-            return iterator{ _head->next };
+            return _head == nullptr ? iterator{} : iterator{ _head, _head->skip.begin()[0] };
         }
 
         const_iterator begin() const {
-            return iterator{ _head->next };
+            return const_cast<Hive&>(*this).begin();
         }
 
         iterator end() {
-            return iterator{ _head };
+            return _tail == nullptr ? iterator{} : iterator{ _tail, _tail->last };
         }
 
         const_iterator end() const {
-            return iterator{ _head };
+            return const_cast<Hive&>(*this).end();
         }
 
         reverse_iterator rbegin() {
@@ -1207,123 +3471,211 @@ namespace plastic {
         }
 
         size_type max_size() const {
-            return static_cast<size_type>(-1) / sizeof(value_type);
+            return static_cast<size_type>(-1) / sizeof(Slot);
         }
 
-        void resize(size_type new_size) {
-            _resize(new_size);
+        size_type capacity() const {
+            size_type capacity{};
+            for (Group* i{ _head }; i != nullptr; i = i->next) {
+                capacity += i->slots.size();
+            }
+            return capacity;
         }
 
-        void resize(size_type new_size, const_reference value) {
-            this->_resize(new_size, value);
+        MemoryStats memory_stats() const {
+            MemoryStats stats{ .elements = _size, .nodes = _size, .bytes_used = _size * sizeof(value_type) };
+            for (Group* i{ _head }; i != nullptr; i = i->next) {
+                stats.allocations += 3;
+                stats.bytes_allocated += sizeof(Group) + i->slots.size() * sizeof(Slot) + i->skip.size() * sizeof(skip_type);
+            }
+            return stats;
         }
 
-        reference front() {
-            assert(!empty());
-            return *begin();
-        }
+        template <class... Args>
+        iterator emplace(Args&&... args) {
+            if (_free_groups == nullptr) {
+                Group* group{ _tail };
+                if (group == nullptr || group->last == group->slots.size()) {
+                    group = _new_group();
+                }
+                std::ranges::construct_at(group->value(group->last), std::forward<Args>(args)...);
+                ++group->size, ++_size;
+                return { group, group->last++ };
+            }
 
-        const_reference front() const {
-            assert(!empty());
-            return *begin();
-        }
+            // reuse the first slot of an erased run, the rest of the run stays erased
+            Group* group{ _free_groups };
+            size_type index{ group->free_head }, length{ group->skip.begin()[index] };
+            _pop_run(group, index);
+            try {
+                std::ranges::construct_at(group->value(index), std::forward<Args>(args)...);
+            }
+            catch (...) {
+                _push_run(group, index);
+                throw;
+            }
 
-        reference back() {
-            assert(!empty());
-            return *--end();
+            group->skip.begin()[index] = 0;
+            if (length > 1) {
+                _set_run(group, index + 1, length - 1);
+                _push_run(group, index + 1);
+            }
+            if (group->free_head == _none) {
+                _unlink_free(group);
+            }
+            ++group->size, ++_size;
+            return { group, index };
         }
 
-        const_reference back() const {
-            assert(!empty());
-            return *--end();
+        iterator insert(const_reference value) {
+            return emplace(value);
         }
 
-        void push_front(const_reference value) {
-            this->insert(begin(), value);
+        iterator insert(value_type&& value) {
+            return emplace(std::move(value));
         }
 
-        void pop_front() {
-            assert(!empty());
-            this->erase(begin());
+        void insert(size_type count, const_reference value) {
+            while (count-- != 0) {
+                emplace(value);
+            }
         }
 
-        void push_back(const_reference value) {
-            this->insert(end(), value);
+        template <std::input_iterator It>
+        void insert(It first, It last) {
+            while (first != last) {
+                emplace(*first++);
+            }
         }
 
-        void pop_back() {
-            assert(!empty());
-            this->erase(--end());
+        void insert(std::initializer_list<value_type> list) {
+            insert(list.begin(), list.end());
         }
 
-        iterator insert(const_iterator pos, const_reference value) {
-            NodeBase* prev{ pos.base()._ptr->prev };
-            prev->next->next->prev = prev->next = new Node{ prev, prev->next, value };
-            ++_size;
-            return prev->next;
-        }
+        iterator erase(const_iterator pos) {
+            assert(pos != end());
+            Group* group{ pos.base()._group };
+            size_type index{ pos.base()._index };
+            std::ranges::destroy_at(group->value(index));
+            --_size;
+            if (--group->size == 0) {
+                Group* next{ group->next };
+                _delete_group(group);
+                return next == nullptr ? end() : iterator{ next, next->skip.begin()[0] };
+            }
 
-        iterator insert(const_iterator pos, size_type count, const_reference value) {
-            return this->_insert(pos.base()._ptr, count, value);
+            iterator next{ group, index };
+            ++next;
+
+            skip_type* skip{ group->skip.begin() };
+            size_type left{ index == 0 ? 0 : skip[index - 1] }, right{ skip[index + 1] };
+            bool had_free{ group->free_head != _none };
+            if (right != 0) {
+                _pop_run(group, index + 1);
+            }
+            if (left != 0) {
+                _set_run(group, index - left, left + 1 + right);
+            }
+            else {
+                _set_run(group, index, 1 + right);
+                _push_run(group, index);
+            }
+            if (!had_free) {
+                _link_free(group);
+            }
+            return next;
         }
 
-        template <std::input_iterator It>
-        iterator insert(const_iterator pos, It first, It last) {
-            NodeBase *prev{ pos.base()._ptr->prev }, *cur{ prev };
+        // freeing the last group moves end(), so a range reaching it is checked against the current one
+        iterator erase(const_iterator first, const_iterator last) {
+            if (last == end()) {
+                while (first != end()) {
+                    first = erase(first);
+                }
+                return end();
+            }
+
             while (first != last) {
-                cur = cur->next = new Node{ cur, cur->next, *first };
-                ++first, ++_size;
+                first = erase(first);
             }
-            cur->next->prev = cur;
-            return prev->next;
+            return last.base();
         }
 
-        iterator insert(const_iterator pos, std::initializer_list<value_type> list) {
-            return this->insert(pos, list.begin(), list.end());
+        // finds the element a pointer obtained from this hive refers to
+        iterator get_iterator(const_pointer ptr) {
+            for (Group* i{ _head }; i != nullptr; i = i->next) {
+                auto first{ reinterpret_cast<const Slot*>(ptr) };
+                if (std::less_equal{}(i->slots.begin(), first) && std::less{}(first, i->slots.end())) {
+                    return { i, static_cast<size_type>(first - i->slots.begin()) };
+                }
+            }
+            return end();
         }
 
-        iterator erase(const_iterator pos) {
-            NodeBase* prev{ pos.base()._ptr->prev };
-            delete static_cast<Node*>(std::exchange(prev->next, prev->next->next));
-            --_size;
-            prev->next->prev = prev;
-            return prev->next;
+        const_iterator get_iterator(const_pointer ptr) const {
+            return const_cast<Hive&>(*this).get_iterator(ptr);
         }
 
-        iterator erase(const_iterator first, const_iterator last) {
-            NodeBase *first_ptr{ first.base()._ptr }, *last_ptr{ last.base()._ptr };
-            first_ptr->prev->next = last_ptr;
-            last_ptr->prev = first_ptr->prev;
-            while (first_ptr != last_ptr) {
-                delete static_cast<Node*>(std::exchange(first_ptr, first_ptr->next));
-                --_size;
+        void swap(Hive& other) noexcept {
+            if constexpr (GroupTraits::propagate_on_container_swap::value) {
+                std::ranges::swap(_alloc, other._alloc);
+            }
+            else {
+                assert(_alloc == other._alloc);
             }
-            return first_ptr;
-        }
-
-        void swap(List& other) noexcept {
             std::ranges::swap(_head, other._head);
+            std::ranges::swap(_tail, other._tail);
+            std::ranges::swap(_free_groups, other._free_groups);
             std::ranges::swap(_size, other._size);
         }
 
-        friend void swap(List& left, List& right) noexcept {
+        friend void swap(Hive& left, Hive& right) noexcept {
             left.swap(right);
         }
 
         void clear() {
-            this->erase(begin(), end());
-        }
-
-        friend bool operator==(const List& left, const List& right) {
-            return std::ranges::equal(left, right);
-        }
-
-        friend auto operator<=>(const List& left, const List& right) {
-            return std::lexicographical_compare_three_way(left.begin(), left.end(), right.begin(), right.end());
+            for (iterator i{ begin() }, last{ end() }; i != last; ++i) {
+                std::ranges::destroy_at(std::addressof(*i));
+            }
+            while (_head != nullptr) {
+                Group* group{ std::exchange(_head, _head->next) };
+                GroupTraits::destroy(_alloc, group);
+                GroupTraits::deallocate(_alloc, group, 1);
+            }
+            _tail = _free_groups = nullptr;
+            _size = 0;
         }
     };
 
     template <class It>
-    List(It, It) -> List<std::iter_value_t<It>>;
+    Hive(It, It) -> Hive<std::iter_value_t<It>>;
+
+    template <class It, class Alloc>
+    Hive(It, It, Alloc) -> Hive<std::iter_value_t<It>, Alloc>;
+
+    template <class T, class Alloc>
+    struct is_trivially_relocatable<Hive<T, Alloc>> : is_trivially_relocatable<Alloc> {};
+
+    namespace pmr {
+
+        export template <class T>
+        using Vector = plastic::Vector<T, std::pmr::polymorphic_allocator<T>>;
+
+        export template <class T, std::size_t N>
+        using SmallVector = plastic::SmallVector<T, N, std::pmr::polymorphic_allocator<T>>;
+
+        export template <class T>
+        using Deque = plastic::Deque<T, std::pmr::polymorphic_allocator<T>>;
+
+        export template <class T>
+        using SegmentedDeque = plastic::SegmentedDeque<T, std::pmr::polymorphic_allocator<T>>;
+
+        export template <class T>
+        using List = plastic::List<T, std::pmr::polymorphic_allocator<T>>;
+
+        export template <class T>
+        using Hive = plastic::Hive<T, std::pmr::polymorphic_allocator<T>>;
+
+    }
 
 }
@@ -5,10 +5,52 @@ module;
 export module plastic.tree;
 
 import std;
+import plastic.memory;
+import plastic.sequence;
+import plastic.algorithm;
 
 namespace plastic {
 
-    template <class T, class Pr, class Me>
+    // tells bulk insertions that the range is already sorted
+    export struct from_sorted_t {
+        explicit from_sorted_t() = default;
+    };
+
+    export inline constexpr from_sorted_t from_sorted{};
+
+    // lookups take other types of keys as they are when the comparator declares is_transparent
+    template <class K, class Pr, class T>
+    concept lookup_key = std::same_as<K, T> || requires { typename Pr::is_transparent; };
+
+    // keeps the size of every subtree for nth, rank and logarithmic count; with a monoid Mo, which provides
+    // identity(), lift(value) and an associative combine(left, right), also the summary of its values in order
+    export template <class Mo = void>
+    struct OrderStatistics {
+        using monoid_type = Mo;
+        using summary_type = typename Mo::value_type;
+
+        std::size_t size{};
+        summary_type summary{ Mo{}.identity() };
+
+        void update(const OrderStatistics& left, const auto& value, const OrderStatistics& right) {
+            Mo monoid;
+            size = left.size + 1 + right.size;
+            summary = monoid.combine(monoid.combine(left.summary, monoid.lift(value)), right.summary);
+        }
+    };
+
+    template <>
+    struct OrderStatistics<void> {
+        std::size_t size{};
+
+        void update(const OrderStatistics& left, const auto&, const OrderStatistics& right) {
+            size = left.size + 1 + right.size;
+        }
+    };
+
+    struct NoAugmentation {};
+
+    template <class T, class Pr, class Me, class Au>
     class Tree {
     public:
         using value_type = T;
@@ -20,6 +62,9 @@ namespace plastic {
 
     protected:
         using Metadata = Me;
+        using Augmentation = std::conditional_t<std::is_void_v<Au>, NoAugmentation, Au>;
+
+        static constexpr bool _is_augmented{ !std::is_void_v<Au> };
 
         struct NodeBase {
             NodeBase* parent{ this };
@@ -27,6 +72,12 @@ namespace plastic {
             NodeBase* right{ this };
             bool is_head{ true };
             Metadata meta;
+#ifdef _MSC_VER
+            [[msvc::no_unique_address]]
+#else
+            [[no_unique_address]]
+#endif
+            Augmentation aug;
 
             NodeBase* leftmost() {
                 NodeBase* i{ this };
@@ -66,6 +117,8 @@ namespace plastic {
 
                 replaced->left = this;
                 parent = replaced;
+                update();
+                replaced->update();
             }
 
             void right_rotate() {
@@ -90,34 +143,31 @@ namespace plastic {
 
                 replaced->right = this;
                 parent = replaced;
+                update();
+                replaced->update();
+            }
+
+            // recomputes the augmentation from the children, whose own must be up to date
+            void update() {
+                if constexpr (_is_augmented) {
+                    aug.update(left->aug, static_cast<Node*>(this)->value, right->aug);
+                }
             }
         };
 
         struct Node : NodeBase {
             value_type value;
 
-            NodeBase* clone(NodeBase* head, NodeBase* parent) {
-                auto clone{ new Node{ parent, head, head, false, this->meta, value } };
-                if (!this->left->is_head) {
-                    clone->left = static_cast<Node*>(this->left)->clone(head, clone);
-                }
-                if (!this->right->is_head) {
-                    clone->right = static_cast<Node*>(this->right)->clone(head, clone);
-                }
-                return clone;
-            }
-
-            void free() {
-                if (!this->left->is_head) {
-                    static_cast<Node*>(this->left)->free();
-                }
-                if (!this->right->is_head) {
-                    static_cast<Node*>(this->right)->free();
-                }
-                delete this;
-            }
+            template <class... Args>
+            Node(NodeBase* parent, const Metadata& meta, Args&&... args) :
+                NodeBase{ parent, &_leaf, &_leaf, false, meta },
+                value(std::forward<Args>(args)...) {}
         };
 
+        // every leaf is this sentinel, which is shared by all trees of a type so that subtrees can move between them;
+        // like the head it has is_head set, and it is never written to
+        static inline NodeBase _leaf;
+
     public:
         class iterator {
             friend Tree;
@@ -191,160 +241,251 @@ namespace plastic {
         using reverse_iterator = std::reverse_iterator<iterator>;
         using const_reverse_iterator = reverse_iterator;
 
-    protected:
-        comparator _pred;
-        NodeBase* _head{ new NodeBase };
-        size_type _size{};
+        // owns a node extracted from a tree, whose chunks it keeps alive, and gives mutable access to its value
+        class node_type {
+            friend Tree;
 
-    public:
-        Tree() = default;
+            Node* _node{};
+            NodePool<Node> _pool;
 
-        Tree(const Tree& other) :
-            _pred{ other._pred },
-            _size{ other._size } {
+            node_type(Node* node, NodePool<Node>&& pool) :
+                _node{ node },
+                _pool{ std::move(pool) } {}
 
-            if (_size != 0) {
-                NodeBase* clone{ static_cast<Node*>(other._head->parent)->clone(_head, _head) };
-                _head->parent = clone;
-                _head->left = clone->rightmost();
-                _head->right = clone->leftmost();
-            }
-        }
+        public:
+            node_type() = default;
 
-        Tree(Tree&& other) noexcept {
-            this->swap(other);
-        }
+            node_type(node_type&& other) noexcept :
+                _node{ std::exchange(other._node, nullptr) },
+                _pool{ std::move(other._pool) } {}
 
-        ~Tree() {
-            clear();
-            delete _head;
-        }
+            ~node_type() {
+                if (_node != nullptr) {
+                    std::destroy_at(_node);
+                    _pool.deallocate(_node);
+                }
+            }
 
-        Tree& operator=(const Tree& other) {
-            Tree temp(other);
-            this->swap(temp);
-            return *this;
-        }
+            node_type& operator=(node_type&& other) noexcept {
+                node_type temp{ std::move(other) };
+                this->swap(temp);
+                return *this;
+            }
 
-        Tree& operator=(Tree&& other) noexcept {
-            this->swap(other);
-            return *this;
-        }
+            void swap(node_type& other) noexcept {
+                std::ranges::swap(_node, other._node);
+                _pool.swap(other._pool);
+            }
 
-        void swap(Tree& other) noexcept {
-            std::ranges::swap(_pred, other._pred);
-            std::ranges::swap(_head, other._head);
-            std::ranges::swap(_size, other._size);
-        }
+            friend void swap(node_type& left, node_type& right) noexcept {
+                left.swap(right);
+            }
 
-        friend void swap(Tree& left, Tree& right) noexcept {
-            left.swap(right);
-        }
+            bool empty() const {
+                return _node == nullptr;
+            }
 
-        bool empty() const {
-            return _size == 0;
-        }
+            explicit operator bool() const {
+                return _node != nullptr;
+            }
 
-        size_type size() const {
-            return _size;
-        }
+            value_type& value() const {
+                assert(_node != nullptr);
+                return _node->value;
+            }
+        };
 
-        void clear() {
-            if (_size != 0) {
-                static_cast<Node*>(_head->parent)->free();
-                _head->parent = _head->left = _head->right = _head;
-                _size = 0;
+    protected:
+        comparator _pred;
+        NodeBase* _head{ new NodeBase };
+        size_type _size{};
+        NodePool<Node> _pool;
+
+        template <class... Args>
+        Node* _new_node(NodeBase* parent, const Metadata& meta, Args&&... args) {
+            Node* node{ _pool.allocate() };
+            try {
+                std::construct_at(node, parent, meta, std::forward<Args>(args)...);
             }
+            catch (...) {
+                _pool.deallocate(node);
+                throw;
+            }
+            return node;
         }
 
-        const_iterator begin() const {
-            return _head->right;
+        void _delete_node(NodeBase* node) {
+            auto ptr{ static_cast<Node*>(node) };
+            std::destroy_at(ptr);
+            _pool.deallocate(ptr);
         }
 
-        const_iterator end() const {
-            return _head;
+        // moves the values of the subtree at node into nodes of this pool, returning the old ones to from, which they
+        // were allocated from; enough nodes must be reserved and the values nothrow movable
+        NodeBase* _rehome(NodeBase* node, NodeBase* parent, NodePool<Node>& from) noexcept {
+            auto old_node{ static_cast<Node*>(node) };
+            Node* moved{ _pool.allocate() };
+            std::construct_at(moved, parent, node->meta, std::move(old_node->value));
+            moved->aug = node->aug;
+            if (!node->left->is_head) {
+                moved->left = _rehome(node->left, moved, from);
+            }
+            if (!node->right->is_head) {
+                moved->right = _rehome(node->right, moved, from);
+            }
+            std::destroy_at(old_node);
+            from.deallocate(old_node);
+            return moved;
         }
 
-        const_iterator cbegin() const {
-            return begin();
+        // empties the handle; a value that moves without throwing goes into a node of this pool, which is cheaper
+        // than sharing the chunks of the handle for good, otherwise the node is taken over together with them
+        Node* _adopt(node_type& node) {
+            if constexpr (std::is_nothrow_move_constructible_v<value_type>) {
+                Node* adopted{ _new_node(_head, {}, std::move(node._node->value)) };
+                node = {};
+                return adopted;
+            }
+            else {
+                _pool.share(node._pool);
+                return std::exchange(node._node, nullptr);
+            }
         }
 
-        const_iterator cend() const {
-            return end();
+        NodeBase* _clone(const NodeBase* node, NodeBase* parent) {
+            Node* clone{ _new_node(parent, node->meta, static_cast<const Node*>(node)->value) };
+            clone->aug = node->aug;
+            if (!node->left->is_head) {
+                clone->left = _clone(node->left, clone);
+            }
+            if (!node->right->is_head) {
+                clone->right = _clone(node->right, clone);
+            }
+            return clone;
         }
 
-        const_reverse_iterator rbegin() const {
-            return reverse_iterator{ end() };
+        // creates nodes for count elements, chained in order through left and ended by nullptr
+        template <class It>
+        NodeBase* _make_list(It first, size_type count) {
+            NodeBase* list{};
+            NodeBase** tail{ &list };
+            try {
+                while (count-- != 0) {
+                    Node* node{ _new_node(_head, {}, *first) };
+                    ++first;
+                    *tail = node;
+                    tail = &node->left;
+                }
+            }
+            catch (...) {
+                *tail = nullptr;
+                while (list != nullptr) {
+                    _delete_node(std::exchange(list, list->left));
+                }
+                throw;
+            }
+            *tail = nullptr;
+            return list;
         }
 
-        const_reverse_iterator rend() const {
-            return reverse_iterator{ begin() };
-        }
+        // unlinks all nodes into such a list, leaving the tree empty; a visited node's left is never read again
+        NodeBase* _flatten() {
+            NodeBase* list{};
+            NodeBase** tail{ &list };
+            for (iterator i{ begin() }, last{ end() }; i != last;) {
+                NodeBase* node{ i._ptr };
+                ++i;
+                *tail = node;
+                tail = &node->left;
+            }
+            *tail = nullptr;
 
-        const_reverse_iterator crbegin() const {
-            return rbegin();
+            _head->parent = _head->left = _head->right = _head;
+            _size = 0;
+            return list;
         }
 
-        const_reverse_iterator crend() const {
-            return rend();
+        // stable, equal elements of right follow those of left
+        NodeBase* _merge_lists(NodeBase* left, NodeBase* right) const {
+            NodeBase* list{};
+            NodeBase** tail{ &list };
+            while (left != nullptr && right != nullptr) {
+                NodeBase*& from{ std::invoke(_pred, static_cast<Node*>(right)->value, static_cast<Node*>(left)->value) ? right : left };
+                *tail = from;
+                tail = &from->left;
+                from = from->left;
+            }
+            *tail = left != nullptr ? left : right;
+            return list;
         }
 
-        const_reference front() const {
-            return *begin();
-        }
+        // links the next count nodes of the list into a tree of minimal height, returning its root and height;
+        // the derived tree sets the metadata from the depth of a node and the heights of its subtrees
+        std::pair<NodeBase*, int> _build(this auto& self, NodeBase*& list, size_type count, int depth, int max_depth) {
+            if (count == 0) {
+                return { &_leaf, 0 };
+            }
 
-        const_reference back() const {
-            return *--end();
-        }
+            auto [left, left_height]{ self._build(list, count / 2, depth + 1, max_depth) };
+            NodeBase* node{ std::exchange(list, list->left) };
+            auto [right, right_height]{ self._build(list, count - count / 2 - 1, depth + 1, max_depth) };
 
-        const_iterator lower_bound(const_reference value) const {
-            NodeBase *bound{ _head }, *i{ _head->parent };
-            while (!i->is_head) {
-                if (!std::invoke(_pred, static_cast<Node*>(i)->value, value)) {
-                    bound = i;
-                    i = i->left;
-                }
-                else {
-                    i = i->right;
-                }
+            node->left = left;
+            if (!left->is_head) {
+                left->parent = node;
             }
-            return bound;
+            node->right = right;
+            if (!right->is_head) {
+                right->parent = node;
+            }
+            node->meta = self._balanced_meta(depth, max_depth, left_height, right_height);
+            node->update();
+            return { node, std::ranges::max(left_height, right_height) + 1 };
         }
 
-        const_iterator upper_bound(const_reference value) const {
-            NodeBase *bound{ _head }, *i{ _head->parent };
-            while (!i->is_head) {
-                if (std::invoke(_pred, value, static_cast<Node*>(i)->value)) {
-                    bound = i;
-                    i = i->left;
-                }
-                else {
-                    i = i->right;
-                }
+        // replaces the nodes of an empty tree with those of the list
+        void _assign(this auto& self, NodeBase* list, size_type count) {
+            assert(self._size == 0);
+            if (count == 0) {
+                return;
             }
-            return bound;
-        }
 
-        std::pair<const_iterator, const_iterator> equal_range(const_reference value) const {
-            return { this->lower_bound(value), this->upper_bound(value) };
+            self._set_root(self._build(list, count, 0, static_cast<int>(std::bit_width(count)) - 1).first);
+            self._size = count;
         }
 
-        const_iterator find(const_reference value) const {
-            NodeBase* bound{ this->lower_bound(value)._ptr };
-            return !bound->is_head && !std::invoke(_pred, value, static_cast<Node*>(bound)->value) ? bound : _head;
+        // hangs the subtree of root, which may be the leaf, under the head
+        void _set_root(NodeBase* root) {
+            if (root->is_head) {
+                _head->parent = _head->left = _head->right = _head;
+                return;
+            }
+
+            root->parent = _head;
+            _head->parent = root;
+            _head->left = root->rightmost();
+            _head->right = root->leftmost();
         }
 
-        bool contains(const_reference value) const {
-            NodeBase* bound{ this->lower_bound(value)._ptr };
-            return !bound->is_head && !std::invoke(_pred, value, static_cast<Node*>(bound)->value);
+        // rebuilding is linear in the total size, inserting one by one costs a descent per node
+        bool _prefers_rebuild(size_type count) const {
+            return count * std::bit_width(_size + count) >= _size + count;
         }
 
-        size_type count(const_reference value) const {
-            auto [first, last]{ this->equal_range(value) };
-            return std::ranges::distance(first, last);
+        void _merge_list(this auto& self, NodeBase* list, size_type count) {
+            if (self._prefers_rebuild(count)) {
+                size_type size{ self._size + count };
+                self._assign(self._merge_lists(self._flatten(), list), size);
+            }
+            else {
+                while (list != nullptr) {
+                    self._insert_node(std::exchange(list, list->left));
+                }
+            }
         }
 
-        iterator insert(this auto& self, const_reference value) {
+        iterator _insert_node(this auto& self, NodeBase* new_node) {
+            const_reference value{ static_cast<Node*>(new_node)->value };
             NodeBase *parent{ self._head }, *i{ self._head->parent };
             bool is_left{};
             while (!i->is_head) {
@@ -352,8 +493,31 @@ namespace plastic {
                 is_left = std::invoke(self._pred, value, static_cast<Node*>(i)->value);
                 i = is_left ? i->left : i->right;
             }
+            return self._attach(parent, is_left, new_node);
+        }
+
+        // inserts right before hint when the order allows it, otherwise falls back to a descent from the root
+        iterator _insert_node(this auto& self, NodeBase* hint, NodeBase* new_node) {
+            const_reference value{ static_cast<Node*>(new_node)->value };
+            bool fits_before{ hint->is_head || !std::invoke(self._pred, static_cast<Node*>(hint)->value, value) };
+            if (fits_before) {
+                if (hint == self._head->right) {
+                    return self._attach(hint, true, new_node);
+                }
+
+                NodeBase* prev{ (--iterator{ hint })._ptr };
+                if (!std::invoke(self._pred, value, static_cast<Node*>(prev)->value)) {
+                    return hint->left->is_head ? self._attach(hint, true, new_node) : self._attach(prev, false, new_node);
+                }
+            }
+            return self._insert_node(new_node);
+        }
 
-            auto new_node{ new Node{ parent, self._head, self._head, false, {}, value } };
+        // links the node as a leaf under parent, which has no child on that side
+        iterator _attach(this auto& self, NodeBase* parent, bool is_left, NodeBase* new_node) {
+            new_node->left = new_node->right = &_leaf;
+            new_node->meta = {};
+            new_node->parent = parent;
             if (parent->is_head) {
                 parent->parent = new_node;
             }
@@ -370,33 +534,28 @@ namespace plastic {
                 }
             }
 
+            _update_path(new_node);
             self._insert_rebalance(new_node);
             ++self._size;
             return new_node;
         }
 
-        template <std::input_iterator It>
-        void insert(this auto& self, It first, It last) {
-            while (first != last) {
-                self.insert(*first);
-                ++first;
-            }
-        }
-
-        void insert(this auto& self, std::initializer_list<value_type> list) {
-            self.insert(list.begin(), list.end());
-        }
-
-        iterator erase(this auto& self, const_iterator pos) {
-            NodeBase* erased{ pos++._ptr };
+        // detaches the node and rebalances the tree, leaving the node allocated
+        void _unlink(this auto& self, NodeBase* erased) {
             assert(erased != self._head);
 
             NodeBase* parent{ erased->parent };
             NodeBase* left{ erased->left };
             NodeBase* right{ erased->right };
             NodeBase* replaced;
+
+            // the position that lost a node, where rebalancing starts
+            NodeBase* vacated_parent;
+            bool vacated_left;
             if (left->is_head || right->is_head) {
                 replaced = left->is_head ? right : left;
+                vacated_parent = parent;
+                vacated_left = !parent->is_head && erased == parent->left;
 
                 if (parent->is_head) {
                     parent->parent = replaced;
@@ -419,9 +578,11 @@ namespace plastic {
                 }
             }
             else {
-                replaced = pos._ptr;
+                replaced = right->leftmost();
                 NodeBase* replaced_parent{ replaced->parent };
                 NodeBase* replaced_right{ replaced->right };
+                vacated_parent = replaced == right ? replaced : replaced_parent;
+                vacated_left = replaced != right;
 
                 replaced->left = left;
                 left->parent = replaced;
@@ -446,221 +607,2283 @@ namespace plastic {
                     parent->right = replaced;
                 }
                 replaced->parent = parent;
+
+                // the successor takes over the balance information of the erased node
+                std::ranges::swap(replaced->meta, erased->meta);
             }
 
-            self._erase_rebalance(replaced, erased);
-            delete static_cast<Node*>(erased);
+            _update_path(vacated_parent);
+
+            self._erase_rebalance(vacated_parent, vacated_left, erased->meta);
             --self._size;
-            return pos;
         }
 
-        iterator erase(this auto& self, const_iterator first, const_iterator last) {
-            while (first != last) {
-                self.erase(first++);
+        // the path must be brought up to date before rebalancing, as rotations only recompute the nodes they move
+        static void _update_path(NodeBase* node) {
+            if constexpr (_is_augmented) {
+                for (; !node->is_head; node = node->parent) {
+                    node->update();
+                }
             }
-            return last;
         }
 
-        size_type erase(this auto& self, const_reference value) {
-            size_type count{};
-            auto [first, last]{ self.equal_range(value) };
-            while (first != last) {
-                self.erase(first++);
-                ++count;
+        size_type _index(const NodeBase* node) const {
+            if (node->is_head) {
+                return _size;
             }
-            return count;
+
+            size_type index{ node->left->aug.size };
+            for (; !node->parent->is_head; node = node->parent) {
+                if (node == node->parent->right) {
+                    index += node->parent->left->aug.size + 1;
+                }
+            }
+            return index;
         }
 
-        void merge(this auto& self, Tree& other) {
-            if (std::addressof(self) == std::addressof(other)) {
-                return;
+        // the summary of the elements in [first, last) of the subtree of node
+        auto _aggregate(const NodeBase* node, size_type first, size_type last) const {
+            typename Augmentation::monoid_type monoid;
+            if (first == 0 && last == node->aug.size) {
+                return node->aug.summary;
+            }
+            if (first == last) {
+                return monoid.identity();
             }
 
-            self.insert(other.begin(), other.end());
-            other.clear();
+            size_type left_size{ node->left->aug.size };
+            auto summary{ monoid.identity() };
+            if (first < left_size) {
+                summary = _aggregate(node->left, first, std::ranges::min(last, left_size));
+            }
+            if (first <= left_size && left_size < last) {
+                summary = monoid.combine(summary, monoid.lift(static_cast<const Node*>(node)->value));
+            }
+            if (left_size + 1 < last) {
+                first = std::ranges::max(first, left_size + 1) - left_size - 1;
+                summary = monoid.combine(summary, _aggregate(node->right, first, last - left_size - 1));
+            }
+            return summary;
         }
 
-        friend bool operator==(const Tree& left, const Tree& right) {
-            return std::ranges::equal(left, right);
+        static void _destroy(NodeBase* node) {
+            if (!node->left->is_head) {
+                _destroy(node->left);
+            }
+            if (!node->right->is_head) {
+                _destroy(node->right);
+            }
+            std::destroy_at(static_cast<Node*>(node));
         }
 
-        friend auto operator<=>(const Tree& left, const Tree& right) {
-            return std::lexicographical_compare_three_way(left.begin(), left.end(), right.begin(), right.end());
+        std::size_t _delete_subtree(NodeBase* node) {
+            if (node->is_head) {
+                return 0;
+            }
+
+            std::size_t count{ _delete_subtree(node->left) + 1 + _delete_subtree(node->right) };
+            _delete_node(node);
+            return count;
         }
-    };
 
-    struct RedBlackTreeMetadata {
-        bool is_red{ true };
-    };
+    public:
+        Tree() = default;
 
-    export template <class T, class Pr = std::less<T>>
-    class RedBlackTree : public Tree<T, Pr, RedBlackTreeMetadata> {
-        using Base = Tree<T, Pr, RedBlackTreeMetadata>;
+        // the nodes of a copy are allocated next to each other
+        Tree(const Tree& other) :
+            _pred{ other._pred } {
 
-        friend Base;
+            if (other._size != 0) {
+                _pool.reserve(other._size);
+                NodeBase* clone{ _clone(other._head->parent, _head) };
+                _head->parent = clone;
+                _head->left = clone->rightmost();
+                _head->right = clone->leftmost();
+                _size = other._size;
+            }
+        }
 
-        using typename Base::NodeBase;
+        Tree(Tree&& other) noexcept {
+            this->swap(other);
+        }
 
-        void _insert_rebalance(NodeBase* inserted) {
-            NodeBase* i{ inserted };
-            while (i->parent->meta.is_red) {
-                NodeBase* parent{ i->parent };
-                NodeBase* grandparent{ parent->parent };
-                NodeBase* uncle;
-                if (parent == grandparent->left) {
-                    uncle = grandparent->right;
-                    if (!uncle->meta.is_red) {
-                        if (i == parent->right) {
+        ~Tree() {
+            clear();
+            delete _head;
+        }
+
+        Tree& operator=(const Tree& other) {
+            Tree temp(other);
+            this->swap(temp);
+            return *this;
+        }
+
+        Tree& operator=(Tree&& other) noexcept {
+            this->swap(other);
+            return *this;
+        }
+
+        void swap(Tree& other) noexcept {
+            std::ranges::swap(_pred, other._pred);
+            std::ranges::swap(_head, other._head);
+            std::ranges::swap(_size, other._size);
+            _pool.swap(other._pool);
+        }
+
+        friend void swap(Tree& left, Tree& right) noexcept {
+            left.swap(right);
+        }
+
+        bool empty() const {
+            return _size == 0;
+        }
+
+        size_type size() const {
+            return _size;
+        }
+
+        MemoryStats memory_stats() const {
+            MemoryStats stats{ _pool.memory_stats() };
+            stats.elements = stats.nodes = _size;
+            stats.allocations += 1;
+            stats.bytes_allocated += sizeof(NodeBase);
+            stats.bytes_used = _size * sizeof(value_type);
+            return stats;
+        }
+
+        // frees the nodes chunk by chunk, only visiting them when they need destroying; chunks shared with another
+        // tree stay allocated as long as it lives, so their nodes go back to the free list one by one before this
+        // tree lets go of them
+        void clear() {
+            if (_size != 0) {
+                if (_pool.shared()) {
+                    _delete_subtree(_head->parent);
+                    _pool.release();
+                }
+                else {
+                    if constexpr (!std::is_trivially_destructible_v<Node>) {
+                        _destroy(_head->parent);
+                    }
+                    _pool.release();
+                }
+                _head->parent = _head->left = _head->right = _head;
+                _size = 0;
+            }
+        }
+
+        const_iterator begin() const {
+            return _head->right;
+        }
+
+        const_iterator end() const {
+            return _head;
+        }
+
+        const_iterator cbegin() const {
+            return begin();
+        }
+
+        const_iterator cend() const {
+            return end();
+        }
+
+        const_reverse_iterator rbegin() const {
+            return reverse_iterator{ end() };
+        }
+
+        const_reverse_iterator rend() const {
+            return reverse_iterator{ begin() };
+        }
+
+        const_reverse_iterator crbegin() const {
+            return rbegin();
+        }
+
+        const_reverse_iterator crend() const {
+            return rend();
+        }
+
+        const_reference front() const {
+            return *begin();
+        }
+
+        const_reference back() const {
+            return *--end();
+        }
+
+        const_iterator lower_bound(const_reference value) const {
+            return lower_bound<value_type>(value);
+        }
+
+        template <lookup_key<Pr, T> K>
+        const_iterator lower_bound(const K& value) const {
+            NodeBase *bound{ _head }, *i{ _head->parent };
+            while (!i->is_head) {
+                if (!std::invoke(_pred, static_cast<Node*>(i)->value, value)) {
+                    bound = i;
+                    i = i->left;
+                }
+                else {
+                    i = i->right;
+                }
+            }
+            return bound;
+        }
+
+        const_iterator upper_bound(const_reference value) const {
+            return upper_bound<value_type>(value);
+        }
+
+        template <lookup_key<Pr, T> K>
+        const_iterator upper_bound(const K& value) const {
+            NodeBase *bound{ _head }, *i{ _head->parent };
+            while (!i->is_head) {
+                if (std::invoke(_pred, value, static_cast<Node*>(i)->value)) {
+                    bound = i;
+                    i = i->left;
+                }
+                else {
+                    i = i->right;
+                }
+            }
+            return bound;
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const_reference value) const {
+            return equal_range<value_type>(value);
+        }
+
+        template <lookup_key<Pr, T> K>
+        std::pair<const_iterator, const_iterator> equal_range(const K& value) const {
+            return { this->lower_bound(value), this->upper_bound(value) };
+        }
+
+        const_iterator find(const_reference value) const {
+            return find<value_type>(value);
+        }
+
+        template <lookup_key<Pr, T> K>
+        const_iterator find(const K& value) const {
+            NodeBase* bound{ this->lower_bound(value)._ptr };
+            return !bound->is_head && !std::invoke(_pred, value, static_cast<Node*>(bound)->value) ? bound : _head;
+        }
+
+        bool contains(const_reference value) const {
+            return contains<value_type>(value);
+        }
+
+        template <lookup_key<Pr, T> K>
+        bool contains(const K& value) const {
+            NodeBase* bound{ this->lower_bound(value)._ptr };
+            return !bound->is_head && !std::invoke(_pred, value, static_cast<Node*>(bound)->value);
+        }
+
+        size_type count(const_reference value) const {
+            return count<value_type>(value);
+        }
+
+        // logarithmic with order statistics, otherwise linear in the result
+        template <lookup_key<Pr, T> K>
+        size_type count(const K& value) const {
+            auto [first, last]{ this->equal_range(value) };
+            if constexpr (_is_augmented) {
+                return _index(last._ptr) - _index(first._ptr);
+            }
+            else {
+                return std::ranges::distance(first, last);
+            }
+        }
+
+        const_iterator nth(size_type index) const
+            requires _is_augmented {
+
+            assert(index <= _size);
+            if (index == _size) {
+                return _head;
+            }
+
+            NodeBase* i{ _head->parent };
+            while (index != i->left->aug.size) {
+                if (index < i->left->aug.size) {
+                    i = i->left;
+                }
+                else {
+                    index -= i->left->aug.size + 1;
+                    i = i->right;
+                }
+            }
+            return i;
+        }
+
+        // the number of elements before pos
+        size_type rank(const_iterator pos) const
+            requires _is_augmented {
+
+            return _index(pos._ptr);
+        }
+
+        // the number of elements less than value
+        size_type rank(const_reference value) const
+            requires _is_augmented {
+
+            size_type rank{};
+            NodeBase* i{ _head->parent };
+            while (!i->is_head) {
+                if (std::invoke(_pred, static_cast<Node*>(i)->value, value)) {
+                    rank += i->left->aug.size + 1;
+                    i = i->right;
+                }
+                else {
+                    i = i->left;
+                }
+            }
+            return rank;
+        }
+
+        // combines the elements in [first, last) in order
+        auto aggregate(const_iterator first, const_iterator last) const
+            requires requires { typename Augmentation::monoid_type; } {
+
+            size_type first_index{ _index(first._ptr) }, last_index{ _index(last._ptr) };
+            assert(first_index <= last_index);
+            return _aggregate(_head->parent, first_index, last_index);
+        }
+
+        auto aggregate() const
+            requires requires { typename Augmentation::monoid_type; } {
+
+            return _head->parent->aug.summary;
+        }
+
+        // the node is built before the descent, and freed again when a comparison throws
+        template <class... Args>
+        iterator emplace(this auto& self, Args&&... args) {
+            Node* node{ self._new_node(self._head, {}, std::forward<Args>(args)...) };
+            try {
+                return self._insert_node(node);
+            }
+            catch (...) {
+                self._delete_node(node);
+                throw;
+            }
+        }
+
+        // inserts as close as possible before hint, in constant time when the value belongs there
+        template <class... Args>
+        iterator emplace_hint(this auto& self, const_iterator hint, Args&&... args) {
+            Node* node{ self._new_node(self._head, {}, std::forward<Args>(args)...) };
+            try {
+                return self._insert_node(hint._ptr, node);
+            }
+            catch (...) {
+                self._delete_node(node);
+                throw;
+            }
+        }
+
+        iterator insert(this auto& self, const_reference value) {
+            return self.emplace(value);
+        }
+
+        iterator insert(this auto& self, value_type&& value) {
+            return self.emplace(std::move(value));
+        }
+
+        iterator insert(this auto& self, const_iterator hint, const_reference value) {
+            return self.emplace_hint(hint, value);
+        }
+
+        iterator insert(this auto& self, const_iterator hint, value_type&& value) {
+            return self.emplace_hint(hint, std::move(value));
+        }
+
+        // sorted forward ranges are merged in linear time
+        template <std::input_iterator It>
+        void insert(this auto& self, It first, It last) {
+            if constexpr (std::forward_iterator<It>) {
+                if (std::ranges::is_sorted(first, last, self._pred)) {
+                    self.insert(from_sorted, first, last);
+                    return;
+                }
+                self._pool.reserve(static_cast<size_type>(std::ranges::distance(first, last)));
+            }
+            while (first != last) {
+                self.insert(*first);
+                ++first;
+            }
+        }
+
+        template <std::forward_iterator It>
+        void insert(this auto& self, from_sorted_t, It first, It last) {
+            assert(std::ranges::is_sorted(first, last, self._pred));
+            auto count{ static_cast<size_type>(std::ranges::distance(first, last)) };
+            self._pool.reserve(count);
+            self._merge_list(self._make_list(first, count), count);
+        }
+
+        void insert(this auto& self, std::initializer_list<value_type> list) {
+            self.insert(list.begin(), list.end());
+        }
+
+        // takes the element of the handle, leaving it empty unless a comparison throws, in which case the handle
+        // gets the element back in a node of this tree
+        iterator insert(this auto& self, node_type&& node) {
+            if (node.empty()) {
+                return self.end();
+            }
+
+            Node* adopted{ self._adopt(node) };
+            try {
+                return self._insert_node(adopted);
+            }
+            catch (...) {
+                node = { adopted, self._pool.share() };
+                throw;
+            }
+        }
+
+        iterator insert(this auto& self, const_iterator hint, node_type&& node) {
+            if (node.empty()) {
+                return self.end();
+            }
+
+            Node* adopted{ self._adopt(node) };
+            try {
+                return self._insert_node(hint._ptr, adopted);
+            }
+            catch (...) {
+                node = { adopted, self._pool.share() };
+                throw;
+            }
+        }
+
+        iterator erase(this auto& self, const_iterator pos) {
+            NodeBase* erased{ pos++._ptr };
+            self._unlink(erased);
+            self._delete_node(erased);
+            return pos;
+        }
+
+        iterator erase(this auto& self, const_iterator first, const_iterator last) {
+            while (first != last) {
+                self.erase(first++);
+            }
+            return last;
+        }
+
+        size_type erase(this auto& self, const_reference value) {
+            return self.template erase<value_type>(value);
+        }
+
+        template <lookup_key<Pr, T> K>
+            requires (!std::convertible_to<const K&, const_iterator>)
+        size_type erase(this auto& self, const K& value) {
+            size_type count{};
+            auto [first, last]{ self.equal_range(value) };
+            while (first != last) {
+                self.erase(first++);
+                ++count;
+            }
+            return count;
+        }
+
+        // unlinks the element at pos without freeing its node, whose chunks the handle shares
+        node_type extract(this auto& self, const_iterator pos) {
+            NodePool<Node> pool{ self._pool.share() };
+            self._unlink(pos._ptr);
+            return { static_cast<Node*>(pos._ptr), std::move(pool) };
+        }
+
+        node_type extract(this auto& self, const_reference value) {
+            return self.template extract<value_type>(value);
+        }
+
+        // the first element equivalent to value, if any
+        template <lookup_key<Pr, T> K>
+            requires (!std::convertible_to<const K&, const_iterator>)
+        node_type extract(this auto& self, const K& value) {
+            const_iterator pos{ self.find(value) };
+            return pos != self.end() ? self.extract(pos) : node_type{};
+        }
+
+        // moves the nodes of other over without reallocating them, after which other lets go of their chunks
+        void merge(this auto& self, Tree& other) {
+            if (std::addressof(self) == std::addressof(other) || other._size == 0) {
+                return;
+            }
+
+            size_type count{ other._size };
+            self._pool.share(other._pool);
+            self._merge_list(other._flatten(), count);
+            other._pool.release();
+        }
+
+        friend bool operator==(const Tree& left, const Tree& right) {
+            return std::ranges::equal(left, right);
+        }
+
+        friend auto operator<=>(const Tree& left, const Tree& right) {
+            return std::lexicographical_compare_three_way(left.begin(), left.end(), right.begin(), right.end());
+        }
+    };
+
+    // the head and the leaf count as black
+    struct RedBlackTreeMetadata {
+        bool is_red{};
+    };
+
+    export template <class T, class Pr = std::less<T>, class Au = void>
+    class RedBlackTree : public Tree<T, Pr, RedBlackTreeMetadata, Au> {
+        using Base = Tree<T, Pr, RedBlackTreeMetadata, Au>;
+
+        friend Base;
+
+        using typename Base::NodeBase;
+        using typename Base::Node;
+
+        using typename Base::Metadata;
+
+        // restores the colors above the red node i, possibly leaving the root red
+        static void _fix_insertion(NodeBase* i) {
+            while (i->parent->meta.is_red) {
+                NodeBase* parent{ i->parent };
+                NodeBase* grandparent{ parent->parent };
+                NodeBase* uncle;
+                if (parent == grandparent->left) {
+                    uncle = grandparent->right;
+                    if (!uncle->meta.is_red) {
+                        if (i == parent->right) {
                             i = parent;
                             i->left_rotate();
                         }
 
-                        i->parent->meta.is_red = false;
-                        i->parent->parent->meta.is_red = true;
-                        i->parent->parent->right_rotate();
-                        break;
-                    }
+                        i->parent->meta.is_red = false;
+                        i->parent->parent->meta.is_red = true;
+                        i->parent->parent->right_rotate();
+                        break;
+                    }
+                }
+                else {
+                    uncle = grandparent->left;
+                    if (!uncle->meta.is_red) {
+                        if (i == parent->left) {
+                            i = parent;
+                            i->right_rotate();
+                        }
+
+                        i->parent->meta.is_red = false;
+                        i->parent->parent->meta.is_red = true;
+                        i->parent->parent->left_rotate();
+                        break;
+                    }
+                }
+
+                parent->meta.is_red = uncle->meta.is_red = false;
+                grandparent->meta.is_red = true;
+                i = grandparent;
+            }
+        }
+
+        void _insert_rebalance(NodeBase* inserted) {
+            inserted->meta.is_red = true;
+            _fix_insertion(inserted);
+            this->_head->parent->meta.is_red = false;
+        }
+
+        // the vacated position may be the leaf, so its parent is tracked separately
+        void _erase_rebalance(NodeBase* parent, bool is_left, const Metadata& removed) {
+            if (removed.is_red) {
+                return;
+            }
+
+            NodeBase* i{ parent->is_head ? parent->parent : is_left ? parent->left : parent->right };
+            while (i != this->_head->parent && !i->meta.is_red) {
+                NodeBase* brother;
+                if (is_left) {
+                    brother = parent->right;
+                    if (brother->meta.is_red) {
+                        brother->meta.is_red = false;
+                        parent->meta.is_red = true;
+                        parent->left_rotate();
+                        brother = parent->right;
+                    }
+
+                    if (brother->left->meta.is_red || brother->right->meta.is_red) {
+                        if (!brother->right->meta.is_red) {
+                            brother->left->meta.is_red = false;
+                            brother->meta.is_red = true;
+                            brother->right_rotate();
+                            brother = parent->right;
+                        }
+
+                        brother->meta.is_red = parent->meta.is_red;
+                        parent->meta.is_red = false;
+                        brother->right->meta.is_red = false;
+                        parent->left_rotate();
+                        i = this->_head->parent;
+                        break;
+                    }
+                }
+                else {
+                    brother = parent->left;
+                    if (brother->meta.is_red) {
+                        brother->meta.is_red = false;
+                        parent->meta.is_red = true;
+                        parent->right_rotate();
+                        brother = parent->left;
+                    }
+
+                    if (brother->right->meta.is_red || brother->left->meta.is_red) {
+                        if (!brother->left->meta.is_red) {
+                            brother->right->meta.is_red = false;
+                            brother->meta.is_red = true;
+                            brother->left_rotate();
+                            brother = parent->left;
+                        }
+
+                        brother->meta.is_red = parent->meta.is_red;
+                        parent->meta.is_red = false;
+                        brother->left->meta.is_red = false;
+                        parent->right_rotate();
+                        i = this->_head->parent;
+                        break;
+                    }
+                }
+
+                brother->meta.is_red = true;
+                i = parent;
+                parent = i->parent;
+                is_left = i == parent->left;
+            }
+
+            if (!i->is_head) {
+                i->meta.is_red = false;
+            }
+        }
+
+        // a tree of minimal height is valid with only its deepest level red
+        static Metadata _balanced_meta(int depth, int max_depth, int, int) {
+            return { .is_red = depth == max_depth && depth != 0 };
+        }
+
+        // a detached subtree, whose root may be red or the leaf, and the number of black nodes on its paths down;
+        // only nodes inside it are written to while it is transformed, so disjoint subtrees go to different threads
+        struct Subtree {
+            NodeBase* root;
+            int height;
+        };
+
+        // subtrees of this black height have at least 1023 nodes, enough to pay for a thread
+        static constexpr int _parallel_height{ 10 };
+
+        static int _forks() {
+            return static_cast<int>(std::bit_width(std::thread::hardware_concurrency()));
+        }
+
+        Subtree _subtree() const {
+            NodeBase* root{ this->_head->parent };
+            if (root->is_head) {
+                return { &Base::_leaf, 0 };
+            }
+
+            int height{};
+            for (NodeBase* i{ root }; !i->is_head; i = i->left) {
+                height += i->meta.is_red ? 0 : 1;
+            }
+            return { root, height };
+        }
+
+        static void _link(NodeBase* node, NodeBase* left, NodeBase* right) {
+            node->left = left;
+            if (!left->is_head) {
+                left->parent = node;
+            }
+            node->right = right;
+            if (!right->is_head) {
+                right->parent = node;
+            }
+        }
+
+        static std::tuple<Subtree, NodeBase*, Subtree> _expose(Subtree tree) {
+            int height{ tree.height - (tree.root->meta.is_red ? 0 : 1) };
+            return { { tree.root->left, height }, tree.root, { tree.root->right, height } };
+        }
+
+        // links the elements of left, pivot and those of right, which come in this order, in time proportional to
+        // the difference of their black heights
+        static Subtree _join(Subtree left, NodeBase* pivot, Subtree right) {
+            if (left.root->meta.is_red) {
+                left.root->meta.is_red = false;
+                ++left.height;
+            }
+            if (right.root->meta.is_red) {
+                right.root->meta.is_red = false;
+                ++right.height;
+            }
+            if (left.height == right.height) {
+                _link(pivot, left.root, right.root);
+                pivot->meta.is_red = false;
+                pivot->update();
+                return { pivot, left.height + 1 };
+            }
+
+            // the pivot takes the place of the first black node on the inner spine of the taller tree whose height
+            // matches, and the anchor stands in for the head so that rotations at the root stay local
+            bool is_left{ left.height < right.height };
+            Subtree& taller{ is_left ? right : left };
+            int height{ taller.height }, target{ is_left ? left.height : right.height };
+            NodeBase anchor;
+            anchor.parent = taller.root;
+            taller.root->parent = &anchor;
+
+            NodeBase *parent{ &anchor }, *i{ taller.root };
+            while (i->meta.is_red || height != target) {
+                height -= i->meta.is_red ? 0 : 1;
+                parent = i;
+                i = is_left ? i->left : i->right;
+            }
+
+            if (is_left) {
+                _link(pivot, left.root, i);
+                parent->left = pivot;
+            }
+            else {
+                _link(pivot, i, right.root);
+                parent->right = pivot;
+            }
+            pivot->parent = parent;
+            pivot->meta.is_red = true;
+            Base::_update_path(pivot);
+            _fix_insertion(pivot);
+
+            NodeBase* root{ anchor.parent };
+            if (root->meta.is_red) {
+                root->meta.is_red = false;
+                ++taller.height;
+            }
+            return { root, taller.height };
+        }
+
+        // the elements before value and the others, equivalent ones going first when after is set
+        std::pair<Subtree, Subtree> _split(Subtree tree, const T& value, bool after) {
+            if (tree.root->is_head) {
+                return { tree, tree };
+            }
+
+            auto [left, node, right]{ _expose(tree) };
+            const T& key{ static_cast<Node*>(node)->value };
+            if (after ? !std::invoke(this->_pred, value, key) : std::invoke(this->_pred, key, value)) {
+                auto [middle, rest]{ _split(right, value, after) };
+                return { _join(left, node, middle), rest };
+            }
+
+            auto [first, middle]{ _split(left, value, after) };
+            return { first, _join(middle, node, right) };
+        }
+
+        static std::pair<Subtree, NodeBase*> _split_last(Subtree tree) {
+            auto [left, node, right]{ _expose(tree) };
+            if (right.root->is_head) {
+                return { left, node };
+            }
+
+            auto [rest, last]{ _split_last(right) };
+            return { _join(left, node, rest), last };
+        }
+
+        static Subtree _concat(Subtree left, Subtree right) {
+            if (left.root->is_head) {
+                return right;
+            }
+            if (right.root->is_head) {
+                return left;
+            }
+
+            auto [rest, last]{ _split_last(left) };
+            return _join(rest, last, right);
+        }
+
+        // runs both functions, the first on a thread of its own when parallel, and returns their results
+        template <class Fn1, class Fn2>
+        static auto _fork(bool parallel, Fn1 first, Fn2 second) {
+            if (parallel) {
+                auto future{ std::async(std::launch::async, first) };
+                auto result{ second() };
+                return std::pair{ future.get(), result };
+            }
+
+            auto result{ first() };
+            return std::pair{ result, second() };
+        }
+
+        // equivalent elements of right follow those of left
+        Subtree _unite(Subtree left, Subtree right, int forks) const {
+            if (left.root->is_head) {
+                return right;
+            }
+            if (right.root->is_head) {
+                return left;
+            }
+
+            auto [right_left, pivot, right_right]{ _expose(right) };
+            auto [left_left, left_right]{ _split(left, static_cast<Node*>(pivot)->value, true) };
+            bool parallel{ forks > 0 && std::ranges::min(left.height, right.height) >= _parallel_height };
+            auto [first, second]{ _fork(
+                parallel,
+                [&]() { return _unite(left_left, right_left, forks - 1); },
+                [&]() { return _unite(left_right, right_right, forks - 1); }
+            ) };
+            return _join(first, pivot, second);
+        }
+
+        // the elements of tree with an equivalent in the subtree of node, and the others
+        std::pair<Subtree, Subtree> _intersect(Subtree tree, const NodeBase* node, int forks) const {
+            if (tree.root->is_head || node->is_head) {
+                return { { &Base::_leaf, 0 }, tree };
+            }
+
+            const T& value{ static_cast<const Node*>(node)->value };
+            auto [less, rest]{ _split(tree, value, false) };
+            auto [equal, greater]{ _split(rest, value, true) };
+            bool parallel{ forks > 0 && tree.height >= _parallel_height };
+            auto [first, second]{ _fork(
+                parallel,
+                [&]() { return _intersect(less, node->left, forks - 1); },
+                [&]() { return _intersect(greater, node->right, forks - 1); }
+            ) };
+            return { _concat(_concat(first.first, equal), second.first), _concat(first.second, second.second) };
+        }
+
+        // the elements of tree without an equivalent in the subtree of node, and the others
+        std::pair<Subtree, Subtree> _subtract(Subtree tree, const NodeBase* node, int forks) const {
+            if (tree.root->is_head || node->is_head) {
+                return { tree, { &Base::_leaf, 0 } };
+            }
+
+            const T& value{ static_cast<const Node*>(node)->value };
+            auto [less, rest]{ _split(tree, value, false) };
+            auto [equal, greater]{ _split(rest, value, true) };
+            bool parallel{ forks > 0 && tree.height >= _parallel_height };
+            auto [first, second]{ _fork(
+                parallel,
+                [&]() { return _subtract(less, node->left, forks - 1); },
+                [&]() { return _subtract(greater, node->right, forks - 1); }
+            ) };
+            return { _concat(first.first, second.first), _concat(_concat(first.second, equal), second.second) };
+        }
+
+        static std::size_t _count(const NodeBase* node) {
+            if constexpr (Base::_is_augmented) {
+                return node->aug.size;
+            }
+            else {
+                return node->is_head ? 0 : _count(node->left) + 1 + _count(node->right);
+            }
+        }
+
+    public:
+        using Base::Base;
+        using typename Base::value_type;
+
+        template <std::input_iterator It>
+        RedBlackTree(It first, It last) {
+            this->insert(first, last);
+        }
+
+        template <std::forward_iterator It>
+        RedBlackTree(from_sorted_t, It first, It last) {
+            this->insert(from_sorted, first, last);
+        }
+
+        RedBlackTree(std::initializer_list<value_type> list) :
+            RedBlackTree(list.begin(), list.end()) {}
+
+        // the elements of left, pivot and those of right, which must come in this order, in logarithmic time
+        friend RedBlackTree join(RedBlackTree left, value_type pivot, RedBlackTree right) {
+            assert(left.empty() || !std::invoke(left._pred, pivot, left.back()));
+            assert(right.empty() || !std::invoke(left._pred, right.front(), pivot));
+            left._pool.share(right._pool);
+            NodeBase* node{ left._new_node(left._head, {}, std::move(pivot)) };
+            left._set_root(_join(left._subtree(), node, right._subtree()).root);
+            left._size += std::exchange(right._size, 0) + 1;
+            right._set_root(&Base::_leaf);
+            return left;
+        }
+
+        // keeps the elements less than value and returns the others. The smaller part moves its values into nodes
+        // of a pool of its own, so that the trees can be used on different threads, which takes time linear in its
+        // size; values that may throw while moving stay in their nodes, and the trees then share a pool
+        RedBlackTree split(const value_type& value) {
+            RedBlackTree other;
+            other._pred = this->_pred;
+            if constexpr (!std::is_nothrow_move_constructible_v<value_type>) {
+                other._pool.share(this->_pool);
+            }
+            auto [left, right]{ _split(_subtree(), value, false) };
+            std::size_t count{ _count(right.root) };
+            if constexpr (std::is_nothrow_move_constructible_v<value_type>) {
+                bool moves_right{ count <= this->_size - count };
+                try {
+                    other._pool.reserve(moves_right ? count : this->_size - count);
+                }
+                catch (...) {
+                    this->_set_root(_concat(left, right).root);
+                    throw;
+                }
+                if (moves_right) {
+                    right.root = right.root->is_head ? right.root : other._rehome(right.root, other._head, this->_pool);
+                }
+                else {
+                    left.root = left.root->is_head ? left.root : other._rehome(left.root, other._head, this->_pool);
+                    this->_pool.swap(other._pool);
+                }
+            }
+            this->_set_root(left.root);
+            other._set_root(right.root);
+            other._size = count;
+            this->_size -= count;
+            return other;
+        }
+
+        // moves the nodes of other over like merge, in O(m log(n / m + 1)) for sizes m <= n; large trees are
+        // handled by several threads, which call the comparator concurrently
+        void unite(RedBlackTree& other) {
+            if (this == std::addressof(other) || other._size == 0) {
+                return;
+            }
+
+            this->_pool.share(other._pool);
+            this->_set_root(_unite(_subtree(), other._subtree(), _forks()).root);
+            this->_size += std::exchange(other._size, 0);
+            other._set_root(&Base::_leaf);
+            other._pool.release();
+        }
+
+        // keeps the elements with an equivalent in other, in the time of unite
+        void intersect(const RedBlackTree& other) {
+            if (this == std::addressof(other)) {
+                return;
+            }
+
+            auto [kept, dropped]{ _intersect(_subtree(), other._head->parent, _forks()) };
+            this->_set_root(kept.root);
+            this->_size -= this->_delete_subtree(dropped.root);
+        }
+
+        // keeps the elements without an equivalent in other, in the time of unite
+        void subtract(const RedBlackTree& other) {
+            if (this == std::addressof(other)) {
+                this->clear();
+                return;
+            }
+
+            auto [kept, dropped]{ _subtract(_subtree(), other._head->parent, _forks()) };
+            this->_set_root(kept.root);
+            this->_size -= this->_delete_subtree(dropped.root);
+        }
+    };
+
+    template <class It>
+    RedBlackTree(It, It) -> RedBlackTree<std::iter_value_t<It>>;
+
+    struct AvlTreeMetadata {
+        signed char factor{};
+    };
+
+    export template <class T, class Pr = std::less<T>, class Au = void>
+    class AvlTree : public Tree<T, Pr, AvlTreeMetadata, Au> {
+        using Base = Tree<T, Pr, AvlTreeMetadata, Au>;
+
+        friend Base;
+
+        using typename Base::NodeBase;
+
+        using typename Base::Metadata;
+
+        // restores a subtree whose factor reached -2 or 2 and returns its new root, whose factor is 0 unless
+        // the subtree kept its height
+        static NodeBase* _rotate(NodeBase* node) {
+            if (node->meta.factor > 0) {
+                NodeBase* right{ node->right };
+                if (right->meta.factor >= 0) {
+                    node->left_rotate();
+                    right->meta.factor = right->meta.factor == 0 ? -1 : 0;
+                    node->meta.factor = -right->meta.factor;
+                    return right;
+                }
+
+                NodeBase* middle{ right->left };
+                right->right_rotate();
+                node->left_rotate();
+                node->meta.factor = middle->meta.factor > 0 ? -1 : 0;
+                right->meta.factor = middle->meta.factor < 0 ? 1 : 0;
+                middle->meta.factor = 0;
+                return middle;
+            }
+
+            NodeBase* left{ node->left };
+            if (left->meta.factor <= 0) {
+                node->right_rotate();
+                left->meta.factor = left->meta.factor == 0 ? 1 : 0;
+                node->meta.factor = -left->meta.factor;
+                return left;
+            }
+
+            NodeBase* middle{ left->right };
+            left->left_rotate();
+            node->right_rotate();
+            node->meta.factor = middle->meta.factor < 0 ? 1 : 0;
+            left->meta.factor = middle->meta.factor > 0 ? -1 : 0;
+            middle->meta.factor = 0;
+            return middle;
+        }
+
+        // factor is the height of the right subtree minus that of the left one
+        static void _insert_rebalance(NodeBase* inserted) {
+            NodeBase* i{ inserted };
+            while (!i->parent->is_head) {
+                NodeBase* parent{ i->parent };
+                parent->meta.factor += i == parent->left ? -1 : 1;
+                if (parent->meta.factor == 0) {
+                    break;
+                }
+                if (parent->meta.factor == -2 || parent->meta.factor == 2) {
+                    _rotate(parent);
+                    break;
+                }
+                i = parent;
+            }
+        }
+
+        static void _erase_rebalance(NodeBase* parent, bool is_left, const Metadata&) {
+            NodeBase* i{ parent };
+            while (!i->is_head) {
+                i->meta.factor += is_left ? 1 : -1;
+                if (i->meta.factor == -1 || i->meta.factor == 1) {
+                    break;
+                }
+                if (i->meta.factor != 0) {
+                    i = _rotate(i);
+                    if (i->meta.factor != 0) {
+                        break;
+                    }
+                }
+
+                is_left = i == i->parent->left;
+                i = i->parent;
+            }
+        }
+
+        static Metadata _balanced_meta(int, int, int left_height, int right_height) {
+            return { .factor = static_cast<signed char>(right_height - left_height) };
+        }
+
+    public:
+        using Base::Base;
+        using typename Base::value_type;
+
+        template <std::input_iterator It>
+        AvlTree(It first, It last) {
+            this->insert(first, last);
+        }
+
+        template <std::forward_iterator It>
+        AvlTree(from_sorted_t, It first, It last) {
+            this->insert(from_sorted, first, last);
+        }
+
+        AvlTree(std::initializer_list<value_type> list) :
+            AvlTree(list.begin(), list.end()) {}
+    };
+
+    template <class It>
+    AvlTree(It, It) -> AvlTree<std::iter_value_t<It>>;
+
+    // an ordered multiset with up to B values in each leaf and up to B separator keys in each inner node, which are
+    // copies of values; the leaves are linked in order, and insertions and erasures invalidate iterators into them
+    export template <class T, class Pr = std::less<T>, std::size_t B = std::ranges::max(std::size_t{ 16 }, 256 / sizeof(T))>
+        requires (B >= 3 && std::is_nothrow_move_constructible_v<T>)
+    class BTree {
+    public:
+        using value_type = T;
+        using comparator = Pr;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+    private:
+        // nodes other than the root hold at least this many values or keys
+        static constexpr size_type _min_count{ (B - 1) / 2 };
+
+        struct Inner;
+
+        struct Node {
+            Inner* parent{};
+            size_type count{};
+        };
+
+        struct Leaf : Node {
+            Leaf* prev{};
+            Leaf* next{};
+
+            union {
+                value_type values[B];
+            };
+
+            Leaf() {}
+
+            ~Leaf() {}
+        };
+
+        // the values under children[i] are not greater than keys[i], and those under children[i + 1] not less
+        struct Inner : Node {
+            union {
+                value_type keys[B];
+            };
+
+            Node* children[B + 1];
+
+            Inner() {}
+
+            ~Inner() {}
+        };
+
+    public:
+        class iterator {
+            friend BTree;
+
+            Leaf* _leaf{};
+            size_type _index{};
+
+            iterator(Leaf* leaf, size_type index) :
+                _leaf{ leaf },
+                _index{ index } {}
+
+        public:
+            using value_type = T;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::bidirectional_iterator_tag;
+
+            iterator() = default;
+
+            reference operator*() const {
+                return _leaf->values[_index];
+            }
+
+            pointer operator->() const {
+                return std::addressof(_leaf->values[_index]);
+            }
+
+            friend bool operator==(iterator left, iterator right) {
+                return left._leaf == right._leaf && left._index == right._index;
+            }
+
+            // only the end of the last leaf is a valid position past its values
+            iterator& operator++() {
+                if (++_index == _leaf->count && _leaf->next != nullptr) {
+                    _leaf = _leaf->next;
+                    _index = 0;
+                }
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator temp{ *this };
+                ++*this;
+                return temp;
+            }
+
+            iterator& operator--() {
+                if (_index == 0) {
+                    _leaf = _leaf->prev;
+                    _index = _leaf->count;
+                }
+                --_index;
+                return *this;
+            }
+
+            iterator operator--(int) {
+                iterator temp{ *this };
+                --*this;
+                return temp;
+            }
+        };
+
+        using const_iterator = iterator;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = reverse_iterator;
+
+    private:
+        comparator _pred;
+        Node* _root{};
+        Leaf* _first{};
+        Leaf* _last{};
+        size_type _height{};
+        size_type _size{};
+        size_type _nodes{};
+        NodePool<Leaf> _leaves;
+        NodePool<Inner> _inners;
+
+        Leaf* _new_leaf() {
+            Leaf* leaf{ std::construct_at(_leaves.allocate()) };
+            ++_nodes;
+            return leaf;
+        }
+
+        Inner* _new_inner() {
+            Inner* inner{ std::construct_at(_inners.allocate()) };
+            ++_nodes;
+            return inner;
+        }
+
+        // moves values into possibly overlapping uninitialized storage, leaving the source uninitialized
+        static void _relocate(value_type* first, value_type* last, value_type* dest) {
+            if constexpr (is_trivially_relocatable_v<value_type>) {
+                uninitialized_relocate(first, last, dest);
+            }
+            else if (dest < first) {
+                for (; first != last; ++first, ++dest) {
+                    std::construct_at(dest, std::move(*first));
+                    std::destroy_at(first);
+                }
+            }
+            else {
+                for (dest += last - first; first != last;) {
+                    std::construct_at(--dest, std::move(*--last));
+                    std::destroy_at(last);
+                }
+            }
+        }
+
+        // the number of keys ordered before value, or not after it when upper is set; scalar keys are counted
+        // without branches so that the loop vectorizes, and std::lower_bound, unlike the ranges version, does not
+        // require a transparent comparator to order two probes
+        template <bool upper, class K>
+        size_type _search(const value_type* keys, size_type count, const K& value) const {
+            if constexpr (std::is_scalar_v<value_type>) {
+                size_type index{};
+                for (size_type i{}; i != count; ++i) {
+                    if constexpr (upper) {
+                        index += !std::invoke(_pred, value, keys[i]);
+                    }
+                    else {
+                        index += std::invoke(_pred, keys[i], value);
+                    }
+                }
+                return index;
+            }
+            else if constexpr (upper) {
+                return std::upper_bound(keys, keys + count, value, _pred) - keys;
+            }
+            else {
+                return std::lower_bound(keys, keys + count, value, _pred) - keys;
+            }
+        }
+
+        // the position of the bound in the leaf it descends to, which may be past its values
+        template <bool upper, class K>
+        iterator _bound(const K& value) const {
+            Node* node{ _root };
+            for (size_type i{ _height }; i != 0; --i) {
+                auto inner{ static_cast<Inner*>(node) };
+                node = inner->children[_search<upper>(inner->keys, inner->count, value)];
+            }
+            auto leaf{ static_cast<Leaf*>(node) };
+            return { leaf, _search<upper>(leaf->values, leaf->count, value) };
+        }
+
+        static iterator _normalize(Leaf* leaf, size_type index) {
+            return index == leaf->count && leaf->next != nullptr ? iterator{ leaf->next, 0 } : iterator{ leaf, index };
+        }
+
+        static const_reference _front(const Node* node, size_type height) {
+            for (; height != 0; --height) {
+                node = static_cast<const Inner*>(node)->children[0];
+            }
+            return static_cast<const Leaf*>(node)->values[0];
+        }
+
+        static size_type _child_index(const Inner* parent, const Node* child) {
+            return std::ranges::find(parent->children, parent->children + parent->count + 1, child) - parent->children;
+        }
+
+        static void _insert_key(Inner* inner, size_type pos, value_type&& key, Node* child) {
+            _relocate(inner->keys + pos, inner->keys + inner->count, inner->keys + pos + 1);
+            std::construct_at(inner->keys + pos, std::move(key));
+            std::ranges::copy_backward(inner->children + pos + 1, inner->children + inner->count + 1, inner->children + inner->count + 2);
+            inner->children[pos + 1] = child;
+            child->parent = inner;
+            ++inner->count;
+        }
+
+        // closes the gap left by keys[pos], which is already gone, and drops children[pos + 1]
+        static void _remove_key(Inner* inner, size_type pos) {
+            _relocate(inner->keys + pos + 1, inner->keys + inner->count, inner->keys + pos);
+            std::ranges::copy(inner->children + pos + 2, inner->children + inner->count + 1, inner->children + pos + 1);
+            --inner->count;
+        }
+
+        // links right next to left under their parent, splitting full ancestors; the pools must have room reserved
+        void _insert_child(Node* left, value_type&& key, Node* right) {
+            Inner* parent{ left->parent };
+            if (parent == nullptr) {
+                Inner* root{ _new_inner() };
+                std::construct_at(root->keys, std::move(key));
+                root->children[0] = left;
+                root->children[1] = right;
+                root->count = 1;
+                left->parent = right->parent = root;
+                _root = root;
+                ++_height;
+                return;
+            }
+
+            size_type pos{ _child_index(parent, left) };
+            if (parent->count == B) {
+                constexpr size_type middle{ B / 2 };
+                Inner* sibling{ _new_inner() };
+                _relocate(parent->keys + middle + 1, parent->keys + B, sibling->keys);
+                std::ranges::copy(parent->children + middle + 1, parent->children + B + 1, sibling->children);
+                sibling->count = B - middle - 1;
+                for (size_type i{}; i <= sibling->count; ++i) {
+                    sibling->children[i]->parent = sibling;
+                }
+
+                value_type separator(std::move(parent->keys[middle]));
+                std::destroy_at(parent->keys + middle);
+                parent->count = middle;
+                _insert_child(parent, std::move(separator), sibling);
+                if (pos > middle) {
+                    parent = sibling;
+                    pos -= middle + 1;
+                }
+            }
+            _insert_key(parent, pos, std::move(key), right);
+        }
+
+        iterator _insert_at(Leaf* leaf, size_type index, value_type&& value) {
+            if (leaf->count == B) {
+                size_type splits{};
+                Inner* i{ leaf->parent };
+                for (; i != nullptr && i->count == B; i = i->parent) {
+                    ++splits;
+                }
+                _inners.reserve(splits + (i == nullptr));
+                _leaves.reserve(1);
+
+                constexpr size_type middle{ B / 2 };
+                value_type key(leaf->values[middle]);
+                Leaf* right{ _new_leaf() };
+                _relocate(leaf->values + middle, leaf->values + B, right->values);
+                right->count = B - middle;
+                leaf->count = middle;
+                right->prev = leaf;
+                right->next = leaf->next;
+                (leaf->next != nullptr ? leaf->next->prev : _last) = right;
+                leaf->next = right;
+                _insert_child(leaf, std::move(key), right);
+
+                if (index > middle) {
+                    leaf = right;
+                    index -= middle;
+                }
+            }
+
+            _relocate(leaf->values + index, leaf->values + leaf->count, leaf->values + index + 1);
+            std::construct_at(leaf->values + index, std::move(value));
+            ++leaf->count;
+            ++_size;
+            return { leaf, index };
+        }
+
+        iterator _insert(value_type&& value) {
+            if (_root == nullptr) {
+                _root = _first = _last = _new_leaf();
+            }
+            iterator pos{ _bound<true>(value) };
+            return _insert_at(pos._leaf, pos._index, std::move(value));
+        }
+
+        // appends the values of right to left and unlinks right, whose separator is keys[key] of their parent
+        void _merge_leaves(Leaf* left, Leaf* right, size_type key) {
+            _relocate(right->values, right->values + right->count, left->values + left->count);
+            left->count += right->count;
+            left->next = right->next;
+            (right->next != nullptr ? right->next->prev : _last) = left;
+
+            Inner* parent{ left->parent };
+            std::destroy_at(parent->keys + key);
+            _remove_key(parent, key);
+            _leaves.deallocate(right);
+            --_nodes;
+            _rebalance(parent);
+        }
+
+        // the separator comes down between the keys of left and right
+        void _merge_inners(Inner* left, Inner* right, size_type key) {
+            Inner* parent{ left->parent };
+            _relocate(parent->keys + key, parent->keys + key + 1, left->keys + left->count);
+            _relocate(right->keys, right->keys + right->count, left->keys + left->count + 1);
+            std::ranges::copy(right->children, right->children + right->count + 1, left->children + left->count + 1);
+            for (size_type i{}; i <= right->count; ++i) {
+                right->children[i]->parent = left;
+            }
+            left->count += right->count + 1;
+
+            _remove_key(parent, key);
+            _inners.deallocate(right);
+            --_nodes;
+        }
+
+        // refills an inner node that fell below the minimum from a sibling, or merges it and goes on with the parent
+        void _rebalance(Inner* node) {
+            while (node->parent != nullptr && node->count < _min_count) {
+                Inner* parent{ node->parent };
+                size_type pos{ _child_index(parent, node) };
+                auto prev{ pos != 0 ? static_cast<Inner*>(parent->children[pos - 1]) : nullptr };
+                auto next{ pos != parent->count ? static_cast<Inner*>(parent->children[pos + 1]) : nullptr };
+
+                if (prev != nullptr && prev->count > _min_count) {
+                    _relocate(node->keys, node->keys + node->count, node->keys + 1);
+                    _relocate(parent->keys + pos - 1, parent->keys + pos, node->keys);
+                    _relocate(prev->keys + prev->count - 1, prev->keys + prev->count, parent->keys + pos - 1);
+                    std::ranges::copy_backward(node->children, node->children + node->count + 1, node->children + node->count + 2);
+                    node->children[0] = prev->children[prev->count];
+                    node->children[0]->parent = node;
+                    --prev->count;
+                    ++node->count;
+                    return;
+                }
+                if (next != nullptr && next->count > _min_count) {
+                    _relocate(parent->keys + pos, parent->keys + pos + 1, node->keys + node->count);
+                    _relocate(next->keys, next->keys + 1, parent->keys + pos);
+                    _relocate(next->keys + 1, next->keys + next->count, next->keys);
+                    node->children[node->count + 1] = next->children[0];
+                    node->children[node->count + 1]->parent = node;
+                    std::ranges::copy(next->children + 1, next->children + next->count + 1, next->children);
+                    --next->count;
+                    ++node->count;
+                    return;
+                }
+
+                if (prev != nullptr) {
+                    _merge_inners(prev, node, pos - 1);
+                }
+                else {
+                    _merge_inners(node, next, pos);
+                }
+                node = parent;
+            }
+
+            if (node == _root && node->count == 0) {
+                _root = node->children[0];
+                _root->parent = nullptr;
+                --_height;
+                _inners.deallocate(node);
+                --_nodes;
+            }
+        }
+
+        static void _destroy_keys(Node* node, size_type height) {
+            if (height != 0) {
+                auto inner{ static_cast<Inner*>(node) };
+                std::ranges::destroy(inner->keys, inner->keys + inner->count);
+                for (size_type i{}; i <= inner->count; ++i) {
+                    _destroy_keys(inner->children[i], height - 1);
+                }
+            }
+        }
+
+        // fills an empty tree with count values taken in order from next(), shared evenly by the nodes of each level
+        void _build(size_type count, auto next) {
+            assert(_root == nullptr);
+            if (count == 0) {
+                return;
+            }
+
+            size_type leaf_count{ (count - 1) / B + 1 };
+            Storage<Node*> level(leaf_count);
+            try {
+                _leaves.reserve(leaf_count);
+                for (size_type i{}; i != leaf_count; ++i) {
+                    Leaf* leaf{ _new_leaf() };
+                    if (_last == nullptr) {
+                        _first = leaf;
+                    }
+                    else {
+                        _last->next = leaf;
+                        leaf->prev = _last;
+                    }
+                    _last = leaf;
+                    level.begin()[i] = leaf;
+
+                    size_type size{ count / leaf_count + (i < count % leaf_count) };
+                    for (; leaf->count != size; ++leaf->count) {
+                        std::construct_at(leaf->values + leaf->count, next());
+                    }
+                    _size += size;
+                }
+
+                for (size_type level_count{ leaf_count }; level_count != 1; ++_height) {
+                    size_type inner_count{ (level_count - 1) / (B + 1) + 1 }, read{}, built{};
+                    _inners.reserve(inner_count);
+                    try {
+                        for (; built != inner_count; ++built) {
+                            size_type size{ level_count / inner_count + (built < level_count % inner_count) };
+                            Inner* inner{ _new_inner() };
+                            inner->children[0] = level.begin()[read++];
+                            inner->children[0]->parent = inner;
+                            level.begin()[built] = inner;
+                            while (inner->count + 1 != size) {
+                                Node* child{ level.begin()[read] };
+                                std::construct_at(inner->keys + inner->count, _front(child, _height));
+                                inner->children[++inner->count] = child;
+                                child->parent = inner;
+                                ++read;
+                            }
+                        }
+                    }
+                    catch (...) {
+                        for (size_type i{}; i <= built; ++i) {
+                            _destroy_keys(level.begin()[i], _height + 1);
+                        }
+                        for (size_type i{ read }; i != level_count; ++i) {
+                            _destroy_keys(level.begin()[i], _height);
+                        }
+                        throw;
+                    }
+                    level_count = inner_count;
+                }
+            }
+            catch (...) {
+                _root = _first;
+                _height = 0;
+                clear();
+                throw;
+            }
+            _root = level.begin()[0];
+        }
+
+    public:
+        BTree() = default;
+
+        BTree(const BTree& other) :
+            _pred{ other._pred } {
+
+            _build(other._size, [i{ other.begin() }]() mutable -> const_reference { return *i++; });
+        }
+
+        BTree(BTree&& other) noexcept {
+            swap(other);
+        }
+
+        template <std::input_iterator It>
+        BTree(It first, It last) {
+            insert(first, last);
+        }
+
+        template <std::forward_iterator It>
+        BTree(from_sorted_t, It first, It last) {
+            insert(from_sorted, first, last);
+        }
+
+        BTree(std::initializer_list<value_type> list) :
+            BTree(list.begin(), list.end()) {}
+
+        ~BTree() {
+            clear();
+        }
+
+        BTree& operator=(const BTree& other) {
+            BTree temp(other);
+            swap(temp);
+            return *this;
+        }
+
+        BTree& operator=(BTree&& other) noexcept {
+            swap(other);
+            return *this;
+        }
+
+        void swap(BTree& other) noexcept {
+            std::ranges::swap(_pred, other._pred);
+            std::ranges::swap(_root, other._root);
+            std::ranges::swap(_first, other._first);
+            std::ranges::swap(_last, other._last);
+            std::ranges::swap(_height, other._height);
+            std::ranges::swap(_size, other._size);
+            std::ranges::swap(_nodes, other._nodes);
+            _leaves.swap(other._leaves);
+            _inners.swap(other._inners);
+        }
+
+        friend void swap(BTree& left, BTree& right) noexcept {
+            left.swap(right);
+        }
+
+        bool empty() const {
+            return _size == 0;
+        }
+
+        size_type size() const {
+            return _size;
+        }
+
+        MemoryStats memory_stats() const {
+            MemoryStats stats{ _leaves.memory_stats() }, inner_stats{ _inners.memory_stats() };
+            stats.elements = _size;
+            stats.nodes = _nodes;
+            stats.allocations += inner_stats.allocations;
+            stats.bytes_allocated += inner_stats.bytes_allocated;
+            stats.bytes_used = _size * sizeof(value_type);
+            return stats;
+        }
+
+        void clear() {
+            if (_root != nullptr) {
+                if constexpr (!std::is_trivially_destructible_v<value_type>) {
+                    for (Leaf* i{ _first }; i != nullptr; i = i->next) {
+                        std::ranges::destroy(i->values, i->values + i->count);
+                    }
+                    _destroy_keys(_root, _height);
+                }
+                _leaves.release();
+                _inners.release();
+                _root = _first = _last = nullptr;
+                _height = _size = _nodes = 0;
+            }
+        }
+
+        const_iterator begin() const {
+            return { _first, 0 };
+        }
+
+        const_iterator end() const {
+            return { _last, _last != nullptr ? _last->count : 0 };
+        }
+
+        const_iterator cbegin() const {
+            return begin();
+        }
+
+        const_iterator cend() const {
+            return end();
+        }
+
+        const_reverse_iterator rbegin() const {
+            return reverse_iterator{ end() };
+        }
+
+        const_reverse_iterator rend() const {
+            return reverse_iterator{ begin() };
+        }
+
+        const_reverse_iterator crbegin() const {
+            return rbegin();
+        }
+
+        const_reverse_iterator crend() const {
+            return rend();
+        }
+
+        const_reference front() const {
+            return *begin();
+        }
+
+        const_reference back() const {
+            return *--end();
+        }
+
+        const_iterator lower_bound(const_reference value) const {
+            return lower_bound<value_type>(value);
+        }
+
+        template <lookup_key<Pr, T> K>
+        const_iterator lower_bound(const K& value) const {
+            if (_root == nullptr) {
+                return end();
+            }
+            iterator bound{ _bound<false>(value) };
+            return _normalize(bound._leaf, bound._index);
+        }
+
+        const_iterator upper_bound(const_reference value) const {
+            return upper_bound<value_type>(value);
+        }
+
+        template <lookup_key<Pr, T> K>
+        const_iterator upper_bound(const K& value) const {
+            if (_root == nullptr) {
+                return end();
+            }
+            iterator bound{ _bound<true>(value) };
+            return _normalize(bound._leaf, bound._index);
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const_reference value) const {
+            return equal_range<value_type>(value);
+        }
+
+        template <lookup_key<Pr, T> K>
+        std::pair<const_iterator, const_iterator> equal_range(const K& value) const {
+            return { lower_bound(value), upper_bound(value) };
+        }
+
+        const_iterator find(const_reference value) const {
+            return find<value_type>(value);
+        }
+
+        template <lookup_key<Pr, T> K>
+        const_iterator find(const K& value) const {
+            iterator bound{ lower_bound(value) };
+            return bound != end() && !std::invoke(_pred, value, *bound) ? bound : end();
+        }
+
+        bool contains(const_reference value) const {
+            return contains<value_type>(value);
+        }
+
+        template <lookup_key<Pr, T> K>
+        bool contains(const K& value) const {
+            iterator bound{ lower_bound(value) };
+            return bound != end() && !std::invoke(_pred, value, *bound);
+        }
+
+        size_type count(const_reference value) const {
+            return count<value_type>(value);
+        }
+
+        template <lookup_key<Pr, T> K>
+        size_type count(const K& value) const {
+            auto [first, last]{ equal_range(value) };
+            return std::ranges::distance(first, last);
+        }
+
+        template <class... Args>
+        iterator emplace(Args&&... args) {
+            return _insert(value_type(std::forward<Args>(args)...));
+        }
+
+        // inserts as close as possible before hint, without a descent when the value belongs there; between two
+        // leaves the separator is unknown, so only a value equivalent to one of the neighbors skips it
+        template <class... Args>
+        iterator emplace_hint(const_iterator hint, Args&&... args) {
+            value_type value(std::forward<Args>(args)...);
+            if (_root == nullptr || hint._index != hint._leaf->count && std::invoke(_pred, *hint, value)) {
+                return _insert(std::move(value));
+            }
+
+            Leaf* leaf{ hint._leaf };
+            if (hint._index != 0) {
+                if (!std::invoke(_pred, value, leaf->values[hint._index - 1])) {
+                    return _insert_at(leaf, hint._index, std::move(value));
+                }
+            }
+            else if (leaf == _first || !std::invoke(_pred, value, *hint)) {
+                return _insert_at(leaf, 0, std::move(value));
+            }
+            else {
+                Leaf* prev{ leaf->prev };
+                const_reference prev_value{ prev->values[prev->count - 1] };
+                if (!std::invoke(_pred, value, prev_value) && !std::invoke(_pred, prev_value, value)) {
+                    return _insert_at(prev, prev->count, std::move(value));
+                }
+            }
+            return _insert(std::move(value));
+        }
+
+        iterator insert(const_reference value) {
+            return emplace(value);
+        }
+
+        iterator insert(value_type&& value) {
+            return emplace(std::move(value));
+        }
+
+        iterator insert(const_iterator hint, const_reference value) {
+            return emplace_hint(hint, value);
+        }
+
+        iterator insert(const_iterator hint, value_type&& value) {
+            return emplace_hint(hint, std::move(value));
+        }
+
+        // sorted forward ranges are merged in linear time
+        template <std::input_iterator It>
+        void insert(It first, It last) {
+            if constexpr (std::forward_iterator<It>) {
+                if (std::ranges::is_sorted(first, last, _pred)) {
+                    insert(from_sorted, first, last);
+                    return;
+                }
+            }
+            while (first != last) {
+                emplace(*first);
+                ++first;
+            }
+        }
+
+        template <std::forward_iterator It>
+        void insert(from_sorted_t, It first, It last) {
+            assert(std::ranges::is_sorted(first, last, _pred));
+            auto count{ static_cast<size_type>(std::ranges::distance(first, last)) };
+            if (_size == 0) {
+                clear();
+                _build(count, [&first]() -> decltype(auto) { return *first++; });
+            }
+            else {
+                BTree other;
+                other._pred = _pred;
+                other._build(count, [&first]() -> decltype(auto) { return *first++; });
+                merge(other);
+            }
+        }
+
+        void insert(std::initializer_list<value_type> list) {
+            insert(list.begin(), list.end());
+        }
+
+        iterator erase(const_iterator pos) {
+            Leaf* leaf{ pos._leaf };
+            size_type index{ pos._index };
+            assert(index < leaf->count);
+
+            std::destroy_at(leaf->values + index);
+            _relocate(leaf->values + index + 1, leaf->values + leaf->count, leaf->values + index);
+            --leaf->count;
+            --_size;
+
+            if (leaf->parent != nullptr && leaf->count < _min_count) {
+                Inner* parent{ leaf->parent };
+                size_type child{ _child_index(parent, leaf) };
+                Leaf* prev{ child != 0 ? leaf->prev : nullptr };
+                Leaf* next{ child != parent->count ? leaf->next : nullptr };
+
+                if (prev != nullptr && prev->count > _min_count) {
+                    _relocate(leaf->values, leaf->values + leaf->count, leaf->values + 1);
+                    _relocate(prev->values + prev->count - 1, prev->values + prev->count, leaf->values);
+                    --prev->count;
+                    ++leaf->count;
+                    ++index;
+                    parent->keys[child - 1] = leaf->values[0];
+                }
+                else if (next != nullptr && next->count > _min_count) {
+                    _relocate(next->values, next->values + 1, leaf->values + leaf->count);
+                    _relocate(next->values + 1, next->values + next->count, next->values);
+                    --next->count;
+                    ++leaf->count;
+                    parent->keys[child] = next->values[0];
+                }
+                else if (prev != nullptr) {
+                    index += prev->count;
+                    _merge_leaves(prev, leaf, child - 1);
+                    leaf = prev;
                 }
                 else {
-                    uncle = grandparent->left;
-                    if (!uncle->meta.is_red) {
-                        if (i == parent->left) {
-                            i = parent;
-                            i->right_rotate();
-                        }
-
-                        i->parent->meta.is_red = false;
-                        i->parent->parent->meta.is_red = true;
-                        i->parent->parent->left_rotate();
-                        break;
-                    }
+                    _merge_leaves(leaf, next, child);
                 }
+            }
+            return _normalize(leaf, index);
+        }
 
-                parent->meta.is_red = uncle->meta.is_red = false;
-                grandparent->meta.is_red = true;
-                i = grandparent;
+        iterator erase(const_iterator first, const_iterator last) {
+            for (auto count{ std::ranges::distance(first, last) }; count != 0; --count) {
+                first = erase(first);
             }
+            return first;
+        }
 
-            this->_head->parent->meta.is_red = false;
+        size_type erase(const_reference value) {
+            return erase<value_type>(value);
         }
 
-        void _erase_rebalance(NodeBase* replaced, NodeBase* erased) {
-            std::ranges::swap(replaced->meta.is_red, erased->meta.is_red);
+        template <lookup_key<Pr, T> K>
+            requires (!std::convertible_to<const K&, const_iterator>)
+        size_type erase(const K& value) {
+            auto [first, last]{ equal_range(value) };
+            auto count{ static_cast<size_type>(std::ranges::distance(first, last)) };
+            erase(first, last);
+            return count;
+        }
 
-            NodeBase* i{ replaced };
-            if (i->meta.is_red) {
+        // small merges insert one by one, others rebuild the tree in linear time
+        void merge(BTree& other) {
+            if (this == std::addressof(other) || other._size == 0) {
                 return;
             }
 
-            while (!i->parent->is_head && !i->meta.is_red) {
-                NodeBase* parent{ i->parent };
-                NodeBase* brother;
-                if (i == parent->left) {
-                    brother = parent->right;
-                    if (brother->meta.is_red) {
-                        brother->meta.is_red = false;
-                        parent->meta.is_red = true;
-                        parent->left_rotate();
-                        brother = parent->right;
-                    }
+            if (other._size * std::bit_width(_size + other._size) < _size + other._size) {
+                for (iterator i{ other.begin() }, last{ other.end() }; i != last; ++i) {
+                    _insert(std::move(i._leaf->values[i._index]));
+                }
+            }
+            else {
+                BTree merged;
+                merged._pred = _pred;
+                iterator left{ begin() }, left_last{ end() }, right{ other.begin() }, right_last{ other.end() };
+                merged._build(_size + other._size, [&]() -> value_type&& {
+                    iterator& from{ left == left_last || right != right_last && std::invoke(_pred, *right, *left) ? right : left };
+                    value_type& value{ from._leaf->values[from._index] };
+                    ++from;
+                    return std::move(value);
+                });
+                swap(merged);
+            }
+            other.clear();
+        }
 
-                    if (brother->left->meta.is_red || brother->right->meta.is_red) {
-                        if (!brother->right->meta.is_red) {
-                            brother->left->meta.is_red = false;
-                            brother->meta.is_red = true;
-                            brother->right_rotate();
-                            brother = parent->right;
-                        }
+        friend bool operator==(const BTree& left, const BTree& right) {
+            return std::ranges::equal(left, right);
+        }
 
-                        brother->meta.is_red = parent->meta.is_red;
-                        parent->meta.is_red = false;
-                        brother->right->meta.is_red = false;
-                        parent->left_rotate();
-                        break;
-                    }
+        friend auto operator<=>(const BTree& left, const BTree& right) {
+            return std::lexicographical_compare_three_way(left.begin(), left.end(), right.begin(), right.end());
+        }
+    };
+
+    template <class It>
+    BTree(It, It) -> BTree<std::iter_value_t<It>>;
+
+    // an ordered set of unique values, kept sorted in a Vector; after freeze, lookups descend a copy of the values
+    // in Eytzinger order until the next change, so the first levels share cache lines and the descent has no branches
+    export template <class T, class Pr = std::less<T>>
+    class FlatSet {
+    public:
+        using value_type = T;
+        using comparator = Pr;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = const value_type*;
+        using const_iterator = iterator;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = reverse_iterator;
+
+    private:
+        Pr _pred;
+        Vector<value_type> _values;
+        // node k of the implicit tree, counted from 1, is at k - 1 and has the children 2k and 2k + 1
+        Vector<value_type> _layout;
+
+        // the index in sorted order of node k of a layout of the given size, which is a complete tree whose last
+        // level holds only its leftmost leaves: all values before one in a perfect tree exist up to the last present
+        // leaf, and every other one is preceded by all present leaves and the inner nodes before it
+        static size_type _rank(size_type k, size_type size) {
+            auto height{ static_cast<int>(std::bit_width(size)) }, depth{ static_cast<int>(std::bit_width(k)) - 1 };
+            size_type leaves{ size + 1 - (size_type{ 1 } << (height - 1)) };
+            size_type perfect{ ((2 * (k - (size_type{ 1 } << depth)) + 1) << (height - 1 - depth)) - 1 };
+            return perfect < 2 * leaves ? perfect : (perfect - 1) / 2 + leaves;
+        }
+
+        template <bool upper, class K>
+        const_iterator _bound(const K& value) const {
+            if (_layout.empty()) {
+                if constexpr (upper) {
+                    return std::upper_bound(begin(), end(), value, _pred);
                 }
                 else {
-                    brother = parent->left;
-                    if (brother->meta.is_red) {
-                        brother->meta.is_red = false;
-                        parent->meta.is_red = true;
-                        parent->right_rotate();
-                        brother = parent->left;
-                    }
-
-                    if (brother->right->meta.is_red || brother->left->meta.is_red) {
-                        if (!brother->left->meta.is_red) {
-                            brother->right->meta.is_red = false;
-                            brother->meta.is_red = true;
-                            brother->left_rotate();
-                            brother = parent->left;
-                        }
+                    return std::lower_bound(begin(), end(), value, _pred);
+                }
+            }
 
-                        brother->meta.is_red = parent->meta.is_red;
-                        parent->meta.is_red = false;
-                        brother->left->meta.is_red = false;
-                        parent->right_rotate();
-                        break;
-                    }
+            size_type size{ _layout.size() }, k{ 1 };
+            while (k <= size) {
+                if constexpr (upper) {
+                    k = 2 * k + !std::invoke(_pred, value, _layout[k - 1]);
+                }
+                else {
+                    k = 2 * k + std::invoke(_pred, _layout[k - 1], value);
                 }
+            }
+            // the last step to the left was from the bound, the ones to the right since then are undone
+            k >>= std::countr_one(k) + 1;
+            return k == 0 ? end() : begin() + _rank(k, size);
+        }
 
-                brother->meta.is_red = true;
-                i = parent;
+        // sorts and merges the values appended from middle on, keeping the first of equivalent ones
+        void _merge_unique(const_iterator middle, bool sorted) {
+            auto first{ _values.begin() }, mid{ first + (middle - begin()) }, last{ _values.end() };
+            if (!sorted) {
+                plastic::sort(mid, last, _pred);
             }
+            plastic::inplace_merge(first, mid, last, _pred);
+            auto removed{ plastic::unique(first, last, [this](const_reference left, const_reference right) {
+                return !std::invoke(_pred, left, right);
+            }) };
+            _values.erase(removed.begin(), removed.end());
+        }
 
-            i->meta.is_red = false;
+        template <class V>
+        std::pair<iterator, bool> _insert(V&& value) {
+            const_iterator pos{ std::lower_bound(begin(), end(), value, _pred) };
+            if (pos != end() && !std::invoke(_pred, value, *pos)) {
+                return { pos, false };
+            }
+            _layout.clear();
+            return { _values.insert(pos, std::forward<V>(value)), true };
         }
 
     public:
-        using Base::Base;
-        using typename Base::value_type;
+        FlatSet() = default;
 
         template <std::input_iterator It>
-        RedBlackTree(It first, It last) {
-            this->insert(first, last);
+        FlatSet(It first, It last) {
+            insert(first, last);
         }
 
-        RedBlackTree(std::initializer_list<value_type> list) :
-            RedBlackTree(list.begin(), list.end()) {}
-    };
+        template <std::forward_iterator It>
+        FlatSet(from_sorted_t, It first, It last) {
+            insert(from_sorted, first, last);
+        }
 
-    template <class It>
-    RedBlackTree(It, It) -> RedBlackTree<std::iter_value_t<It>>;
+        FlatSet(std::initializer_list<value_type> list) :
+            FlatSet(list.begin(), list.end()) {}
 
-    struct AvlTreeMetadata {
-        signed char factor{};
-    };
+        void swap(FlatSet& other) noexcept {
+            std::ranges::swap(_pred, other._pred);
+            _values.swap(other._values);
+            _layout.swap(other._layout);
+        }
 
-    export template <class T, class Pr = std::less<T>>
-    class AvlTree : public Tree<T, Pr, AvlTreeMetadata> {
-        using Base = Tree<T, Pr, AvlTreeMetadata>;
+        friend void swap(FlatSet& left, FlatSet& right) noexcept {
+            left.swap(right);
+        }
 
-        friend Base;
+        bool empty() const {
+            return _values.empty();
+        }
 
-        using typename Base::NodeBase;
+        size_type size() const {
+            return _values.size();
+        }
 
-        static void _insert_rebalance(NodeBase* inserted) {
-            // TODO
+        MemoryStats memory_stats() const {
+            MemoryStats stats{ _values.memory_stats() }, layout_stats{ _layout.memory_stats() };
+            stats.allocations += layout_stats.allocations;
+            stats.bytes_allocated += layout_stats.bytes_allocated;
+            return stats;
         }
 
-        static void _erase_rebalance(NodeBase* replaced, NodeBase* erased) {
-            // TODO
+        void reserve(size_type new_capacity) {
+            _values.reserve(new_capacity);
         }
 
-    public:
-        using Base::Base;
-        using typename Base::value_type;
+        void shrink_to_fit() {
+            _values.shrink_to_fit();
+            _layout.shrink_to_fit();
+        }
+
+        void clear() {
+            _values.clear();
+            _layout.clear();
+        }
+
+        bool frozen() const {
+            return !_layout.empty();
+        }
+
+        // builds the layout for lookups, which takes linear time and as much memory as the values again
+        void freeze() {
+            if (frozen() || empty()) {
+                return;
+            }
+
+            size_type size{ _values.size() };
+            Vector<value_type> layout;
+            layout.reserve(size);
+            for (size_type k{ 1 }; k <= size; ++k) {
+                layout.push_back(_values[_rank(k, size)]);
+            }
+            _layout.swap(layout);
+        }
+
+        void thaw() {
+            _layout.clear();
+        }
+
+        const_iterator begin() const {
+            return _values.begin();
+        }
+
+        const_iterator end() const {
+            return _values.end();
+        }
+
+        const_iterator cbegin() const {
+            return begin();
+        }
+
+        const_iterator cend() const {
+            return end();
+        }
+
+        const_reverse_iterator rbegin() const {
+            return reverse_iterator{ end() };
+        }
+
+        const_reverse_iterator rend() const {
+            return reverse_iterator{ begin() };
+        }
+
+        const_reverse_iterator crbegin() const {
+            return rbegin();
+        }
+
+        const_reverse_iterator crend() const {
+            return rend();
+        }
+
+        const_reference front() const {
+            return _values.front();
+        }
+
+        const_reference back() const {
+            return _values.back();
+        }
 
+        const_reference operator[](size_type index) const {
+            return _values[index];
+        }
+
+        const value_type* data() const {
+            return _values.data();
+        }
+
+        const_iterator lower_bound(const_reference value) const {
+            return lower_bound<value_type>(value);
+        }
+
+        template <lookup_key<Pr, T> K>
+        const_iterator lower_bound(const K& value) const {
+            return _bound<false>(value);
+        }
+
+        const_iterator upper_bound(const_reference value) const {
+            return upper_bound<value_type>(value);
+        }
+
+        template <lookup_key<Pr, T> K>
+        const_iterator upper_bound(const K& value) const {
+            return _bound<true>(value);
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const_reference value) const {
+            return equal_range<value_type>(value);
+        }
+
+        template <lookup_key<Pr, T> K>
+        std::pair<const_iterator, const_iterator> equal_range(const K& value) const {
+            return { lower_bound(value), upper_bound(value) };
+        }
+
+        const_iterator find(const_reference value) const {
+            return find<value_type>(value);
+        }
+
+        template <lookup_key<Pr, T> K>
+        const_iterator find(const K& value) const {
+            const_iterator bound{ lower_bound(value) };
+            return bound != end() && !std::invoke(_pred, value, *bound) ? bound : end();
+        }
+
+        bool contains(const_reference value) const {
+            return contains<value_type>(value);
+        }
+
+        template <lookup_key<Pr, T> K>
+        bool contains(const K& value) const {
+            const_iterator bound{ lower_bound(value) };
+            return bound != end() && !std::invoke(_pred, value, *bound);
+        }
+
+        size_type count(const_reference value) const {
+            return count<value_type>(value);
+        }
+
+        template <lookup_key<Pr, T> K>
+        size_type count(const K& value) const {
+            auto [first, last]{ equal_range(value) };
+            return last - first;
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args&&... args) {
+            return _insert(value_type(std::forward<Args>(args)...));
+        }
+
+        std::pair<iterator, bool> insert(const_reference value) {
+            return _insert(value);
+        }
+
+        std::pair<iterator, bool> insert(value_type&& value) {
+            return _insert(std::move(value));
+        }
+
+        // appends the values, then sorts them, merges them in and drops the duplicates
         template <std::input_iterator It>
-        AvlTree(It first, It last) {
-            this->insert(first, last);
+        void insert(It first, It last) {
+            size_type size{ _values.size() };
+            _values.insert(end(), first, last);
+            if (size != _values.size()) {
+                _layout.clear();
+                _merge_unique(begin() + size, false);
+            }
         }
 
-        AvlTree(std::initializer_list<value_type> list) :
-            AvlTree(list.begin(), list.end()) {}
+        template <std::forward_iterator It>
+        void insert(from_sorted_t, It first, It last) {
+            assert(std::ranges::is_sorted(first, last, _pred));
+            size_type size{ _values.size() };
+            _values.insert(end(), first, last);
+            if (size != _values.size()) {
+                _layout.clear();
+                _merge_unique(begin() + size, true);
+            }
+        }
+
+        void insert(std::initializer_list<value_type> list) {
+            insert(list.begin(), list.end());
+        }
+
+        iterator erase(const_iterator pos) {
+            _layout.clear();
+            return _values.erase(pos);
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            if (first != last) {
+                _layout.clear();
+            }
+            return _values.erase(first, last);
+        }
+
+        size_type erase(const_reference value) {
+            return erase<value_type>(value);
+        }
+
+        template <lookup_key<Pr, T> K>
+            requires (!std::convertible_to<const K&, const_iterator>)
+        size_type erase(const K& value) {
+            auto [first, last]{ equal_range(value) };
+            auto count{ static_cast<size_type>(last - first) };
+            erase(first, last);
+            return count;
+        }
+
+        friend bool operator==(const FlatSet& left, const FlatSet& right) {
+            return left._values == right._values;
+        }
+
+        friend auto operator<=>(const FlatSet& left, const FlatSet& right) {
+            return left._values <=> right._values;
+        }
     };
 
     template <class It>
-    AvlTree(It, It) -> AvlTree<std::iter_value_t<It>>;
+    FlatSet(It, It) -> FlatSet<std::iter_value_t<It>>;
 
 }
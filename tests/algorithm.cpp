@@ -782,6 +782,62 @@ namespace tests {
             plastic::prev_permutation(a.begin(), a.end());
             ASSERT(a == "abc");
         }
+
+        TEST_METHOD(segmented_iterators) {
+            plastic::Deque<int> d{ 3, 4, 5 };
+            d.push_front(2);
+            d.push_front(1);
+            auto [head, tail]{ segments(d.begin(), d.end()) };
+            ASSERT(head.size() + tail.size() == 5);
+            ASSERT(!tail.empty());
+
+            ASSERT(plastic::find(d.begin(), d.end(), 4) == d.begin() + 3);
+            ASSERT(plastic::find(d.cbegin(), d.cend(), 1) == d.cbegin());
+            ASSERT(plastic::find(d.begin(), d.end(), 6) == d.end());
+            ASSERT(plastic::contains(d.begin(), d.end(), 5) == true);
+
+            int sum{};
+            plastic::for_each(d.cbegin(), d.cend(), [&](int x) { sum += x; });
+            ASSERT(sum == 15);
+
+            std::vector<int> v(5);
+            ASSERT(plastic::copy(d.begin(), d.end(), v.begin()).out == v.end());
+            ASSERT(format(v) == "[1, 2, 3, 4, 5]");
+            std::ranges::reverse(v);
+            ASSERT(plastic::copy(v.begin(), v.end(), d.begin()).out == d.end());
+            ASSERT(format(d) == "[5, 4, 3, 2, 1]");
+
+            plastic::sort(d.begin(), d.end());
+            ASSERT(format(d) == "[1, 2, 3, 4, 5]");
+            plastic::fill(d.begin() + 1, d.end() - 1, 0);
+            ASSERT(format(d) == "[1, 0, 0, 0, 5]");
+
+            plastic::SegmentedDeque<int> s;
+            for (int i{}; i != 10'000; ++i) {
+                s.push_back(i);
+                s.push_front(-i - 1);
+            }
+            ASSERT(std::ranges::distance(segments(s.begin(), s.end())) > 2);
+            ASSERT(plastic::find(s.begin(), s.end(), 1234) == s.begin() + 11'234);
+            ASSERT(plastic::find(s.cbegin() + 1, s.cend() - 1, 9'999) == s.cend() - 1);
+
+            plastic::Vector<int> w(s.size());
+            plastic::copy(s.begin(), s.end(), w.begin());
+            ASSERT(std::ranges::equal(s, w));
+            std::ranges::reverse(w);
+            plastic::copy(w.begin(), w.end(), s.begin());
+            plastic::sort(s.begin(), s.end());
+            ASSERT(std::ranges::is_sorted(s));
+            plastic::fill(s.begin() + 5, s.end(), 7);
+            ASSERT(plastic::find_if(s.begin(), s.end(), [](int x) { return x == 7; }) == s.begin() + 5);
+
+            plastic::SegmentedDeque<std::string> words;
+            for (int i{}; i != 1000; ++i) {
+                words.push_front(std::to_string(i));
+            }
+            plastic::sort(words.begin() + 1, words.end());
+            ASSERT(words.front() == "999" && std::ranges::is_sorted(words.begin() + 1, words.end()) && words.size() == 1000);
+        }
     };
 
 }
@@ -0,0 +1,231 @@
+#include <CppUnitTest.h>
+
+#define ASSERT Microsoft::VisualStudio::CppUnitTestFramework::Assert::IsTrue
+
+import std;
+import plastic;
+import utils;
+
+namespace tests {
+
+    TEST_CLASS(concurrent) {
+    public:
+        TEST_METHOD(spsc_ring) {
+            plastic::SpscRing<std::unique_ptr<int>> r(3);
+            ASSERT(r.capacity() == 4);
+            ASSERT(r.empty());
+            ASSERT(!r.try_pop());
+            for (int i{}; i != 4; ++i) {
+                ASSERT(r.try_push(std::make_unique<int>(i)));
+            }
+            auto rejected{ std::make_unique<int>(4) };
+            ASSERT(!r.try_push(std::move(rejected)));
+            ASSERT(rejected != nullptr);
+            ASSERT(**r.try_pop() == 0);
+            ASSERT(r.try_emplace(new int{ 4 }));
+            ASSERT(r.size() == 4);
+
+            std::vector<std::unique_ptr<int>> out;
+            ASSERT(r.try_pop_n(std::back_inserter(out), 10) == 4);
+            ASSERT(*out.front() == 1 && *out.back() == 4);
+
+            plastic::SpscRing<int> q(64);
+            std::array data{ 1, 2, 3, 4, 5 };
+            ASSERT(q.try_push_n(data.begin(), 5) == 5);
+            int popped[3]{};
+            ASSERT(q.try_pop_n(popped, 3) == 3);
+            ASSERT(std::ranges::equal(popped, std::array{ 1, 2, 3 }));
+
+            constexpr int count{ 100'000 };
+            plastic::SpscRing<int> s(128);
+            std::jthread producer{ [&] {
+                for (int i{}; i != count;) {
+                    int batch[16];
+                    std::iota(batch, batch + 16, i);
+                    i += static_cast<int>(s.try_push_n(batch, std::ranges::min(16, count - i)));
+                }
+            } };
+
+            long long sum{};
+            int expected{};
+            bool ordered{ true };
+            while (expected != count) {
+                if (auto value{ s.try_pop() }) {
+                    ordered &= *value == expected++;
+                    sum += *value;
+                }
+            }
+            ASSERT(ordered);
+            ASSERT(sum == 1LL * count * (count - 1) / 2);
+        }
+
+        TEST_METHOD(mpmc_ring) {
+            plastic::MpmcRing<std::string> r(2);
+            ASSERT(r.try_push("a"));
+            ASSERT(r.try_emplace(1, 'b'));
+            ASSERT(!r.try_push("c"));
+            ASSERT(*r.try_pop() == "a");
+            ASSERT(r.try_push("c"));
+            std::string out[3];
+            ASSERT(r.try_pop_n(out, 3) == 2);
+            ASSERT(out[0] == "b" && out[1] == "c");
+            ASSERT(!r.try_pop());
+
+            // a value whose construction throws never takes up a cell
+            struct Fragile {
+                std::string value;
+
+                Fragile(int value) :
+                    value{ std::to_string(value) } {
+
+                    if (value < 0) {
+                        throw std::invalid_argument{ "negative" };
+                    }
+                }
+            };
+            plastic::MpmcRing<Fragile> f(4);
+            int values[]{ 1, -2, 3 };
+            for (auto push : { 0, 1 }) {
+                try {
+                    push == 0 ? f.try_emplace(-1) : f.try_push_n(values, 3) != 0;
+                    ASSERT(false);
+                }
+                catch (const std::invalid_argument&) {}
+            }
+            ASSERT(f.size() == 1 && f.try_push_n(values + 2, 1) == 1 && f.try_emplace(4));
+            ASSERT(f.try_pop()->value == "1" && f.try_pop()->value == "3" && f.try_pop()->value == "4" && !f.try_pop());
+
+            constexpr int threads{ 4 }, count{ 50'000 };
+            plastic::MpmcRing<int> q(256);
+            std::atomic<long long> sum{};
+            std::atomic<int> consumed{};
+            {
+                std::vector<std::jthread> workers;
+                for (int t{}; t != threads; ++t) {
+                    workers.emplace_back([&, t] {
+                        for (int i{}; i != count;) {
+                            if (i % 3 == 0) {
+                                int batch[]{ t * count + i, t * count + i + 1 };
+                                i += static_cast<int>(q.try_push_n(batch, std::ranges::min(2, count - i)));
+                            }
+                            else if (q.try_push(t * count + i)) {
+                                ++i;
+                            }
+                        }
+                    });
+                    workers.emplace_back([&] {
+                        int batch[8];
+                        while (consumed.load() != threads * count) {
+                            auto popped{ static_cast<int>(q.try_pop_n(batch, 8)) };
+                            sum += std::reduce(batch, batch + popped, 0LL);
+                            consumed += popped;
+                        }
+                    });
+                }
+            }
+            ASSERT(q.empty());
+            ASSERT(sum == 1LL * threads * count * (threads * count - 1) / 2);
+        }
+
+        TEST_METHOD(concurrent_vector) {
+            plastic::ConcurrentVector<int> v1;
+            ASSERT(format(v1) == "[]");
+            plastic::ConcurrentVector v2(3, 4);
+            ASSERT(format(v2) == "[4, 4, 4]");
+            plastic::ConcurrentVector v3{ 1, 2, 3 };
+            ASSERT(format(v3) == "[1, 2, 3]");
+            plastic::ConcurrentVector v4(v3);
+            ASSERT(v4 == v3);
+            plastic::ConcurrentVector v5(std::move(v4));
+            ASSERT(v5 == v3 && v4.empty());
+
+            plastic::ConcurrentVector<std::string> s;
+            std::string& first{ s.push_back("a") };
+            for (int i{}; i != 100; ++i) {
+                s.emplace_back(1, 'b');
+            }
+            ASSERT(&first == &s[0] && first == "a");
+            auto grown{ s.grow_by(2, "c") };
+            ASSERT(grown - s.begin() == 101 && *grown == "c" && s.back() == "c");
+            ASSERT(s.size() == 103 && s.capacity() >= 103);
+            s.clear();
+            ASSERT(s.empty() && s.capacity() >= 103);
+
+            // a throwing construction breaks the vector until it is cleared, the elements before it stay readable
+            struct Fragile {
+                int value;
+
+                Fragile(int value) :
+                    value{ value } {
+
+                    if (value < 0) {
+                        throw std::invalid_argument{ "negative" };
+                    }
+                }
+            };
+            auto rejects{ [](auto&& f) {
+                try {
+                    f();
+                }
+                catch (const std::runtime_error&) {
+                    return true;
+                }
+                return false;
+            } };
+            plastic::ConcurrentVector<Fragile> f{ 1, 2 };
+            bool thrown{};
+            try {
+                f.emplace_back(-1);
+            }
+            catch (const std::invalid_argument&) {
+                thrown = true;
+            }
+            ASSERT(thrown);
+            ASSERT(f.broken() && rejects([&] { f.push_back(3); }) && rejects([&] { f.grow_by(1, 4); }));
+            ASSERT(f.size() == 2 && f.back().value == 2);
+            f.clear();
+            f.emplace_back(5);
+            ASSERT(!f.broken() && f.size() == 1 && f[0].value == 5);
+
+            constexpr int threads{ 4 }, count{ 20'000 };
+            plastic::ConcurrentVector<int> v;
+            std::atomic<bool> stable{ true };
+            {
+                std::vector<std::jthread> workers;
+                for (int t{}; t != threads; ++t) {
+                    workers.emplace_back([&, t] {
+                        std::vector<int*> mine;
+                        for (int i{}; i != count; i += 2) {
+                            if (i % 4 == 0) {
+                                mine.push_back(&v.push_back(t * count + i));
+                                mine.push_back(&v.push_back(t * count + i + 1));
+                            }
+                            else {
+                                std::array batch{ t * count + i, t * count + i + 1 };
+                                auto iter{ v.grow_by(batch.begin(), batch.end()) };
+                                mine.push_back(&iter[0]);
+                                mine.push_back(&iter[1]);
+                            }
+                        }
+                        for (int i{}; i != count; ++i) {
+                            stable = stable && *mine[i] == t * count + i;
+                        }
+                    });
+                }
+                workers.emplace_back([&] {
+                    for (std::size_t seen{}; seen != threads * count;) {
+                        std::size_t size{ v.size() };
+                        stable = stable && size >= seen && (size == 0 || v[size - 1] >= 0);
+                        seen = size;
+                    }
+                });
+            }
+            ASSERT(stable);
+            ASSERT(v.size() == threads * count);
+            plastic::sort(v.begin(), v.end());
+            ASSERT(std::ranges::equal(v, std::views::iota(0, threads * count)));
+            ASSERT(plastic::find(v.begin(), v.end(), 12345) - v.begin() == 12345);
+        }
+    };
+
+}
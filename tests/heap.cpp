@@ -55,6 +55,9 @@ namespace tests {
         ASSERT(tests::format_heap(x) == "[0, 0, 1, 1, 2, 3, 3, 4]");
         auto h2{ x.push(1) };
         ASSERT(tests::format_heap(x) == "[0, 0, 1, 1, 1, 2, 3, 3, 4]");
+        x.emplace(5);
+        ASSERT(tests::format_heap(x) == "[0, 0, 1, 1, 1, 2, 3, 3, 4, 5]");
+        x.pop();
 
         x.pop();
         ASSERT(tests::format_heap(x) == "[0, 0, 1, 1, 1, 2, 3, 3]");
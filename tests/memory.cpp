@@ -0,0 +1,240 @@
+#include <CppUnitTest.h>
+
+#define ASSERT Microsoft::VisualStudio::CppUnitTestFramework::Assert::IsTrue
+
+import std;
+import plastic;
+import utils;
+
+namespace tests {
+
+    TEST_CLASS(memory) {
+    public:
+        TEST_METHOD(storage) {
+            plastic::Storage<int> e, a(3);
+            ASSERT(e.size() == 0);
+            ASSERT(e.begin() == nullptr);
+            ASSERT(a.size() == 3);
+            ASSERT(a.end() - a.begin() == 3);
+
+            plastic::Storage<int> x{ std::move(a) };
+            ASSERT(x.size() == 3);
+            ASSERT(a.size() == 0);
+            x.swap(e);
+            ASSERT(x.size() == 0);
+            ASSERT(e.size() == 3);
+        }
+
+        TEST_METHOD(relocation) {
+            static_assert(plastic::is_trivially_relocatable_v<int>);
+            static_assert(plastic::is_trivially_relocatable_v<std::unique_ptr<int>>);
+            static_assert(plastic::is_trivially_relocatable_v<plastic::Vector<std::string>>);
+            static_assert(!plastic::is_trivially_relocatable_v<std::string>);
+            static_assert(plastic::Storage<int>::is_reallocatable);
+            static_assert(!plastic::Storage<std::unique_ptr<int>>::is_reallocatable);
+
+            int buffer[]{ 1, 2, 3, 4, 5 };
+            ASSERT(plastic::uninitialized_relocate(buffer, buffer + 3, buffer + 2) == buffer + 5);
+            ASSERT(std::ranges::equal(buffer, std::array{ 1, 2, 1, 2, 3 }));
+
+            plastic::Vector<std::shared_ptr<int>> v;
+            for (int i{}; i != 100; ++i) {
+                v.push_back(std::make_shared<int>(i));
+            }
+            v.insert(v.begin() + 1, std::make_shared<int>(-1));
+            v.erase(v.begin() + 2, v.begin() + 50);
+            v.erase(v.begin());
+            ASSERT(v.size() == 52);
+            ASSERT(*v[0] == -1);
+            ASSERT(*v[1] == 49);
+            ASSERT(*v.back() == 99);
+
+            plastic::Vector<int> w{ 1, 2, 3 };
+            w.insert(w.begin() + 1, 3, 0);
+            w.insert(w.end() - 1, { 4, 5 });
+            w.reserve(1000);
+            ASSERT(format(w) == "[1, 0, 0, 0, 2, 4, 5, 3]");
+
+            plastic::Deque<std::shared_ptr<int>> d;
+            for (int i{}; i != 5; ++i) {
+                d.push_back(std::make_shared<int>(i));
+            }
+            d.pop_front();
+            d.pop_front();
+            d.push_back(std::make_shared<int>(5));
+            d.push_back(std::make_shared<int>(6));
+            d.push_back(std::make_shared<int>(7));
+            ASSERT(*d.front() == 2);
+            ASSERT(*d.back() == 7);
+            ASSERT(d.size() == 6);
+
+            plastic::Deque<int> e{ 3, 4 };
+            e.push_front(2);
+            e.push_front(1);
+            e.push_back(5);
+            e.reserve(100);
+            ASSERT(format(e) == "[1, 2, 3, 4, 5]");
+        }
+
+        TEST_METHOD(node_pool) {
+            plastic::NodePool<std::array<int, 4>> pool;
+            std::array<int, 4> *a{ pool.allocate() }, *b{ pool.allocate() };
+            pool.deallocate(a);
+            ASSERT(pool.allocate() == a);
+            pool.deallocate(b);
+            pool.reserve(100);
+            std::array<int, 4>* c{ pool.allocate() };
+            for (int i{ 1 }; i != 100; ++i) {
+                ASSERT(pool.allocate() == c + i);
+            }
+            auto owner{ pool.share() };
+            pool.release();
+            ASSERT(owner.memory_stats().allocations == 3);
+            owner.deallocate(c);
+            ASSERT(owner.allocate() == c);
+
+            // reservations take freed slots before adding chunks
+            plastic::NodePool<int> churned;
+            std::vector<int*> nodes;
+            for (int round{}; round != 1000; ++round) {
+                churned.reserve(10);
+                for (int i{}; i != 10; ++i) {
+                    nodes.push_back(churned.allocate());
+                }
+                for (int* i : nodes) {
+                    churned.deallocate(i);
+                }
+                nodes.clear();
+            }
+            ASSERT(churned.memory_stats().allocations == 2);
+
+            plastic::List<int> l(50);
+            l.insert(l.begin(), 50, 1);
+            std::vector<std::uintptr_t> addresses;
+            for (const int& i : l) {
+                addresses.push_back(std::bit_cast<std::uintptr_t>(&i));
+            }
+            for (std::size_t i{ 2 }; i != 50; ++i) {
+                ASSERT(addresses[i] - addresses[i - 1] == addresses[1] - addresses[0]);
+            }
+
+            const int* freed{ &*++l.begin() };
+            l.erase(++l.begin());
+            l.push_back(2);
+            ASSERT(&l.back() == freed);
+            l.clear();
+            l.push_back(3);
+            ASSERT(format(l) == "[3]");
+
+            plastic::AvlTree<std::string> t{ "a", "b", "c" };
+            const std::string* erased{ &*t.find("b") };
+            t.erase("b");
+            ASSERT(&*t.insert("d") == erased);
+            for (int i{}; i != 100; ++i) {
+                t.insert(std::to_string(i));
+            }
+            plastic::AvlTree<std::string> u{ t };
+            ASSERT(u.memory_stats().allocations == 3);
+            ASSERT(u == t);
+            t.clear();
+            ASSERT(t.memory_stats().allocations == 1);
+            t.insert("e");
+            ASSERT(t.size() == 1 && t.front() == "e");
+        }
+
+        TEST_METHOD(memory_stats) {
+            plastic::Vector<int> v;
+            ASSERT(v.memory_stats().allocations == 0);
+            v.reserve(100);
+            v.resize(10);
+            plastic::MemoryStats stats{ v.memory_stats() };
+            ASSERT(stats.elements == 10);
+            ASSERT(stats.allocations == 1);
+            ASSERT(stats.bytes_allocated == 100 * sizeof(int));
+            ASSERT(stats.slack() == 90 * sizeof(int));
+            ASSERT(stats.bytes_per_element() == 10 * sizeof(int));
+            v.shrink_to_fit();
+            ASSERT(v.capacity() == 10);
+            ASSERT(v.memory_stats().slack() == 0);
+            ASSERT(format(v) == "[0, 0, 0, 0, 0, 0, 0, 0, 0, 0]");
+
+            plastic::Vector<std::string> w{ "a", "b" };
+            w.reserve(10);
+            w.shrink_to_fit();
+            ASSERT(w.capacity() == 2 && w[1] == "b");
+            w.clear();
+            w.shrink_to_fit();
+            ASSERT(w.memory_stats().bytes_allocated == 0);
+
+            plastic::SmallVector<int, 4> s{ 1, 2 };
+            ASSERT(s.memory_stats().bytes_allocated == 0);
+
+            plastic::Deque<int> d(8);
+            ASSERT(d.memory_stats().slack() == 0);
+
+            plastic::SegmentedDeque<int> sd(10);
+            ASSERT(sd.memory_stats().allocations >= 2);
+            ASSERT(sd.memory_stats().bytes_used == 10 * sizeof(int));
+
+            plastic::List<int> l(10);
+            stats = l.memory_stats();
+            ASSERT(stats.nodes == 10);
+            ASSERT(stats.allocations == 3);
+            ASSERT(stats.slack() > 0);
+
+            plastic::RedBlackTree<int> t{ 1, 2, 3 };
+            ASSERT(t.memory_stats().allocations == 3);
+
+            plastic::BinaryHeap<int> h{ 1, 2, 3 };
+            ASSERT(h.memory_stats().nodes == 3);
+            ASSERT(h.memory_stats().bytes_per_element() > sizeof(int));
+        }
+
+        TEST_METHOD(monotonic_arena) {
+            plastic::MonotonicArena arena{ 64 };
+
+            plastic::Vector<int, plastic::ArenaAllocator<int>> v(arena);
+            for (int i{}; i != 100; ++i) {
+                v.push_back(i);
+            }
+            ASSERT(v.size() == 100);
+            ASSERT(v.front() == 0);
+            ASSERT(v.back() == 99);
+            ASSERT(v.get_allocator().arena() == &arena);
+
+            plastic::Deque<int, plastic::ArenaAllocator<int>> d({ 3, 2, 1 }, arena);
+            d.push_front(4);
+            d.push_back(0);
+            ASSERT(format(d) == "[4, 3, 2, 1, 0]");
+
+            plastic::List<int, plastic::ArenaAllocator<int>> l({ 3, 2, 1 }, arena);
+            l.push_front(4);
+            l.erase(++l.begin());
+            ASSERT(format(l) == "[4, 2, 1]");
+
+            auto w{ v };
+            ASSERT(w == v);
+            ASSERT(w.get_allocator() == v.get_allocator());
+        }
+
+        TEST_METHOD(polymorphic_allocator) {
+            plastic::MonotonicArena arena;
+
+            plastic::pmr::Vector<int> v{ { 1, 2, 3 }, &arena }, w{ &arena };
+            w = v;
+            w.push_back(4);
+            ASSERT(format(w) == "[1, 2, 3, 4]");
+            ASSERT(w.get_allocator().resource() == &arena);
+
+            plastic::pmr::Vector<int> x;
+            x = std::move(w);
+            ASSERT(format(x) == "[1, 2, 3, 4]");
+            ASSERT(x.get_allocator().resource() == std::pmr::get_default_resource());
+
+            plastic::pmr::List<int> l{ { 3, 2, 1 }, &arena };
+            plastic::pmr::Deque<int> d(l.begin(), l.end(), &arena);
+            ASSERT(format(d) == "[3, 2, 1]");
+        }
+    };
+
+}
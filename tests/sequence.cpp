@@ -104,6 +104,19 @@ namespace tests {
             x.pop_back();
             ASSERT(format(x) == "[3, 2, 1, 5]");
 
+            x = { 3, 2, 1 };
+            ASSERT(x.emplace_back(x.front()) == 3);
+            ASSERT(format(x) == "[3, 2, 1, 3]");
+            ASSERT(*x.emplace(x.begin() + 1, 4) == 4);
+            ASSERT(format(x) == "[3, 4, 2, 1, 3]");
+
+            plastic::Vector<std::unique_ptr<int>> p;
+            p.push_back(std::make_unique<int>(1));
+            p.emplace_back(new int{ 2 });
+            p.emplace(p.begin(), new int{ 0 });
+            p.insert(p.end(), std::make_unique<int>(3));
+            ASSERT(*p[0] == 0 && *p[1] == 1 && *p[2] == 2 && *p[3] == 3);
+
             x = { 3, 2, 1 };
             y = { 0, 1, 2 };
             x.insert(x.begin() + 1, 3);
@@ -115,6 +128,25 @@ namespace tests {
             x.insert(x.end(), { 0 });
             ASSERT(format(x) == "[0, 1, 2, 3, 4, 4, 3, 2, 1, 0]");
 
+            x = { 1, 2 };
+            x.append_range(std::views::iota(3, 6));
+            ASSERT(format(x) == "[1, 2, 3, 4, 5]");
+            x.insert_range(x.begin() + 1, std::array{ 7, 8 });
+            ASSERT(format(x) == "[1, 7, 8, 2, 3, 4, 5]");
+            x.insert_range(x.end() - 1, std::views::iota(0, 3) | std::views::filter([](int i) { return i != 1; }));
+            ASSERT(format(x) == "[1, 7, 8, 2, 3, 4, 0, 2, 5]");
+            std::istringstream in{ "6 9" };
+            x.insert_range(x.begin(), std::views::istream<int>(in));
+            ASSERT(format(x) == "[6, 9, 1, 7, 8, 2, 3, 4, 0, 2, 5]");
+            plastic::Vector r(std::from_range, std::views::iota(0, 4));
+            ASSERT(format(r) == "[0, 1, 2, 3]");
+
+            plastic::Vector<std::string> t{ "a", "b", "c" };
+            t.insert_range(t.begin() + 1, std::array{ "d", "e" });
+            ASSERT(std::ranges::equal(t, std::array{ "a", "d", "e", "b", "c" }));
+            t.insert_range(t.end() - 1, std::array{ "f", "g", "h" });
+            ASSERT(std::ranges::equal(t, std::array{ "a", "d", "e", "b", "f", "g", "h", "c" }));
+
             x = { 5, 4, 3, 2, 1 };
             x.erase(x.begin() + 1);
             ASSERT(format(x) == "[5, 3, 2, 1]");
@@ -144,6 +176,209 @@ namespace tests {
             ASSERT(y >= x);
         }
 
+        TEST_METHOD(small_vector) {
+            std::array arr{ 5, 4, 3, 2, 1 };
+
+            plastic::SmallVector<int, 4> v1;
+            ASSERT(format(v1) == "[]");
+            plastic::SmallVector<int, 4> v2(3);
+            ASSERT(format(v2) == "[0, 0, 0]");
+            plastic::SmallVector<int, 4> v3(4, 4);
+            ASSERT(format(v3) == "[4, 4, 4, 4]");
+            plastic::SmallVector<int, 4> v4(arr.begin(), arr.end());
+            ASSERT(format(v4) == "[5, 4, 3, 2, 1]");
+            plastic::SmallVector v5(v2);
+            ASSERT(format(v5) == "[0, 0, 0]");
+            plastic::SmallVector v6(std::move(v3));
+            ASSERT(format(v6) == "[4, 4, 4, 4]");
+            ASSERT(format(v3) == "[]");
+            plastic::SmallVector<int, 4> v7{ 5, 4, 3, 2, 1 };
+            ASSERT(format(v7) == "[5, 4, 3, 2, 1]");
+
+            plastic::SmallVector<int, 4> e, a{ 3, 2, 1 }, b{ 5, 4, 3, 2, 1 }, x, y;
+
+            ASSERT(e.capacity() == 4);
+            ASSERT(a.capacity() == 4);
+            ASSERT(b.capacity() >= 5);
+            ASSERT(e.data() == std::as_const(e).begin());
+
+            x = { 1, 2, 3 };
+            const int* inline_data{ x.data() };
+            x.push_back(4);
+            ASSERT(x.data() == inline_data);
+            x.push_back(5);
+            ASSERT(x.data() != inline_data);
+            ASSERT(format(x) == "[1, 2, 3, 4, 5]");
+
+            x = a;
+            ASSERT(format(x) == "[3, 2, 1]");
+            x = b;
+            ASSERT(format(x) == "[5, 4, 3, 2, 1]");
+            x = std::move(a);
+            ASSERT(format(x) == "[3, 2, 1]");
+            ASSERT(a.empty());
+
+            x = { 3, 2, 1 };
+            y = { 5, 4, 3, 2, 1 };
+            x.swap(y);
+            ASSERT(format(x) == "[5, 4, 3, 2, 1]");
+            ASSERT(format(y) == "[3, 2, 1]");
+            swap(x, y);
+            ASSERT(format(x) == "[3, 2, 1]");
+            ASSERT(format(y) == "[5, 4, 3, 2, 1]");
+            y = { 0 };
+            x.swap(y);
+            ASSERT(format(x) == "[0]");
+            ASSERT(format(y) == "[3, 2, 1]");
+
+            x = { 3, 2, 1 };
+            x.insert(x.begin() + 1, 2, 4);
+            ASSERT(format(x) == "[3, 4, 4, 2, 1]");
+            x.erase(x.begin(), x.begin() + 2);
+            ASSERT(format(x) == "[4, 2, 1]");
+            x.resize(6, 7);
+            ASSERT(format(x) == "[4, 2, 1, 7, 7, 7]");
+            x.clear();
+            ASSERT(x.empty());
+
+            plastic::SmallVector<std::string, 2> s{ "a", "b" };
+            s.push_back(std::string(32, 'c'));
+            s.insert(s.begin(), "d");
+            ASSERT(s.size() == 4);
+            ASSERT(s.front() == "d");
+            ASSERT(s.back() == std::string(32, 'c'));
+            auto t{ std::move(s) };
+            ASSERT(t.size() == 4);
+            ASSERT(s.empty());
+
+            x = { 1, 2 };
+            y = { 1, 2, 3 };
+            ASSERT(x == x);
+            ASSERT(x != y);
+            ASSERT(x < y);
+            ASSERT(y >= x);
+        }
+
+        TEST_METHOD(inplace_vector) {
+            static_assert(std::is_trivially_copyable_v<plastic::InplaceVector<int, 4>>);
+            static_assert(!std::is_trivially_copyable_v<plastic::InplaceVector<std::string, 4>>);
+            static_assert([] {
+                plastic::InplaceVector<int, 8> v{ 3, 1, 2 };
+                v.insert(v.begin() + 1, 5);
+                v.erase(v.begin());
+                v.insert(v.end(), 2, 0);
+                std::ranges::sort(v);
+                return v == plastic::InplaceVector<int, 8>{ 0, 0, 1, 2, 5 };
+            }());
+
+            plastic::InplaceVector<int, 4> a(2, 7), b{ 1, 2, 3 };
+            ASSERT(format(a) == "[7, 7]");
+            ASSERT(a.capacity() == 4);
+            ASSERT(a.memory_stats().bytes_allocated == 0);
+            b.push_back(4);
+            ASSERT(b.try_push_back(5) == nullptr);
+            bool thrown{};
+            try {
+                b.push_back(5);
+            }
+            catch (const std::bad_alloc&) {
+                thrown = true;
+            }
+            ASSERT(thrown);
+            ASSERT(format(b) == "[1, 2, 3, 4]");
+            b.pop_back();
+            ASSERT(*b.try_emplace_back(9) == 9);
+            a = b;
+            ASSERT(a == b);
+            a.erase(a.begin() + 1, a.end() - 1);
+            ASSERT(format(a) == "[1, 9]");
+            a.swap(b);
+            ASSERT(format(a) == "[1, 2, 3, 9]" && format(b) == "[1, 9]");
+
+            plastic::InplaceVector<std::string, 5> s{ "b", "d" };
+            s.insert(s.begin(), "a");
+            s.emplace(s.begin() + 2, 1, 'c');
+            s.insert_range(s.end(), std::array{ "e" });
+            ASSERT(std::ranges::equal(s, std::array{ "a", "b", "c", "d", "e" }));
+            ASSERT(s.try_emplace_back("f") == nullptr);
+            plastic::InplaceVector<std::string, 5> t{ std::move(s) }, u{ "x" };
+            ASSERT(t.size() == 5 && t.back() == "e");
+            t.swap(u);
+            ASSERT(t.size() == 1 && u.size() == 5 && u[2] == "c");
+            u.resize(2);
+            u = t;
+            ASSERT(std::ranges::equal(u, std::array{ "x" }));
+
+            // a throwing element drops the ones inserted before it
+            auto checked{ std::views::transform([](int i) {
+                if (i < 0) {
+                    throw std::invalid_argument{ "negative" };
+                }
+                return std::to_string(i);
+            }) };
+            std::array values{ 1, -1 };
+            try {
+                u.insert_range(u.begin(), values | checked);
+                ASSERT(false);
+            }
+            catch (const std::invalid_argument&) {}
+            ASSERT(std::ranges::equal(u, std::array{ "x" }));
+        }
+
+        TEST_METHOD(mapped_vector) {
+            struct Record {
+                int key;
+                int value;
+
+                auto operator<=>(const Record&) const = default;
+            };
+
+            auto path{ std::filesystem::temp_directory_path() / "plastic_mapped_vector.bin" };
+            std::filesystem::remove(path);
+
+            {
+                plastic::MappedVector<Record> v{ path };
+                ASSERT(v.is_open());
+                ASSERT(v.empty());
+                for (int i{}; i != 1000; ++i) {
+                    v.emplace_back(i, -i);
+                }
+                v.insert(v.begin(), { 7, 7 });
+                v.erase(v.end() - 1);
+                ASSERT(v.size() == 1000);
+                ASSERT(v.capacity() >= 1000);
+                ASSERT(plastic::is_sorted(v.begin() + 1, v.end()));
+            }
+            ASSERT(std::filesystem::file_size(path) == 1000 * sizeof(Record));
+
+            {
+                plastic::MappedVector<Record> v{ path };
+                ASSERT(v.size() == 1000);
+                ASSERT(v.front() == Record{ 7, 7 });
+                ASSERT(v.back() == Record{ 998, -998 });
+                v.resize(10);
+                v.shrink_to_fit();
+                ASSERT(v.capacity() == 10);
+                v.flush();
+
+                plastic::MappedVector<Record> w{ std::move(v) };
+                ASSERT(!v.is_open());
+                ASSERT(w.size() == 10 && w[9] == Record{ 8, -8 });
+            }
+            ASSERT(std::filesystem::file_size(path) == 10 * sizeof(Record));
+            std::filesystem::remove(path);
+
+            plastic::MappedVector<Record> closed;
+            bool thrown{};
+            try {
+                closed.push_back({ 1, 1 });
+            }
+            catch (const std::system_error& error) {
+                thrown = error.code() == std::errc::bad_file_descriptor;
+            }
+            ASSERT(thrown && closed.empty() && !closed.is_open());
+        }
+
         TEST_METHOD(deque) {
             std::array arr{ 5, 4, 3, 2, 1 };
 
@@ -246,6 +481,20 @@ namespace tests {
             x.pop_back();
             ASSERT(format(x) == "[3, 2, 1, 5]");
 
+            x = { 3, 2, 1 };
+            ASSERT(x.emplace_back(x.front()) == 3);
+            ASSERT(x.emplace_front(x.back()) == 3);
+            ASSERT(format(x) == "[3, 3, 2, 1, 3]");
+            ASSERT(*x.emplace(std::ranges::next(x.begin(), 1), 4) == 4);
+            ASSERT(format(x) == "[3, 4, 3, 2, 1, 3]");
+
+            plastic::Deque<std::unique_ptr<int>> p;
+            p.push_back(std::make_unique<int>(1));
+            p.push_front(std::make_unique<int>(0));
+            p.emplace_back(new int{ 3 });
+            p.insert(std::ranges::prev(p.end()), std::make_unique<int>(2));
+            ASSERT(*p.front() == 0 && **std::ranges::next(p.begin(), 2) == 2 && *p.back() == 3);
+
             x = { 3, 2, 1 };
             y = { 0, 1, 2 };
             x.insert(x.begin() + 1, 3);
@@ -257,6 +506,25 @@ namespace tests {
             x.insert(x.end(), { 0 });
             ASSERT(format(x) == "[0, 1, 2, 3, 4, 4, 3, 2, 1, 0]");
 
+            x = { 1, 2 };
+            x.append_range(std::views::iota(3, 6));
+            ASSERT(format(x) == "[1, 2, 3, 4, 5]");
+            x.insert_range(x.begin() + 1, std::array{ 7, 8 });
+            ASSERT(format(x) == "[1, 7, 8, 2, 3, 4, 5]");
+            x.insert_range(x.end() - 1, std::views::iota(0, 3) | std::views::filter([](int i) { return i != 1; }));
+            ASSERT(format(x) == "[1, 7, 8, 2, 3, 4, 0, 2, 5]");
+            std::istringstream in{ "6 9" };
+            x.insert_range(x.begin(), std::views::istream<int>(in));
+            ASSERT(format(x) == "[6, 9, 1, 7, 8, 2, 3, 4, 0, 2, 5]");
+            plastic::Deque r(std::from_range, std::views::iota(0, 4));
+            ASSERT(format(r) == "[0, 1, 2, 3]");
+
+            plastic::Deque<std::string> t{ "a", "b", "c" };
+            t.insert_range(t.begin() + 1, std::array{ "d", "e" });
+            ASSERT(std::ranges::equal(t, std::array{ "a", "d", "e", "b", "c" }));
+            t.insert_range(t.end() - 1, std::array{ "f", "g", "h" });
+            ASSERT(std::ranges::equal(t, std::array{ "a", "d", "e", "b", "f", "g", "h", "c" }));
+
             x = { 5, 4, 3, 2, 1 };
             x.erase(x.begin() + 1);
             ASSERT(format(x) == "[5, 3, 2, 1]");
@@ -286,6 +554,115 @@ namespace tests {
             ASSERT(y >= x);
         }
 
+        TEST_METHOD(segmented_deque) {
+            std::array arr{ 5, 4, 3, 2, 1 };
+
+            plastic::SegmentedDeque<int> d1;
+            ASSERT(format(d1) == "[]");
+            plastic::SegmentedDeque<int> d2(3);
+            ASSERT(format(d2) == "[0, 0, 0]");
+            plastic::SegmentedDeque d3(4, 4);
+            ASSERT(format(d3) == "[4, 4, 4, 4]");
+            plastic::SegmentedDeque d4(arr.begin(), arr.end());
+            ASSERT(format(d4) == "[5, 4, 3, 2, 1]");
+            plastic::SegmentedDeque d5(d2);
+            ASSERT(format(d5) == "[0, 0, 0]");
+            plastic::SegmentedDeque d6(std::move(d3));
+            ASSERT(format(d6) == "[4, 4, 4, 4]");
+            plastic::SegmentedDeque d7{ 5, 4, 3, 2, 1 };
+            ASSERT(format(d7) == "[5, 4, 3, 2, 1]");
+
+            plastic::SegmentedDeque<int> e, c{ 5, 4, 3, 2, 1 }, x, y{ 3, 2, 1 };
+
+            x = y;
+            ASSERT(format(x) == "[3, 2, 1]");
+            x = std::move(y);
+            ASSERT(format(x) == "[3, 2, 1]");
+            x = { 1, 2, 3 };
+            ASSERT(format(x) == "[1, 2, 3]");
+
+            ASSERT(format(c.rbegin(), c.rend()) == "[1, 2, 3, 4, 5]");
+            ASSERT(format(c.cbegin(), c.cend()) == "[5, 4, 3, 2, 1]");
+            ASSERT(e.empty());
+            ASSERT(c.size() == 5);
+            ASSERT(c[2] == 3);
+            ASSERT(c.front() == 5);
+            ASSERT(c.back() == 1);
+
+            x = { 3, 2, 1 };
+            x.resize(2);
+            ASSERT(format(x) == "[3, 2]");
+            x.resize(5, 1);
+            ASSERT(format(x) == "[3, 2, 1, 1, 1]");
+
+            x = { 3, 2, 1 };
+            x.push_front(4);
+            x.push_back(5);
+            ASSERT(format(x) == "[4, 3, 2, 1, 5]");
+            x.pop_front();
+            x.pop_back();
+            ASSERT(format(x) == "[3, 2, 1]");
+            ASSERT(x.emplace_front(x.back()) == 1);
+            ASSERT(x.emplace_back(x.front()) == 1);
+            ASSERT(format(x) == "[1, 3, 2, 1, 1]");
+
+            x = { 3, 2, 1 };
+            y = { 0, 1, 2 };
+            x.insert(x.begin() + 1, 3);
+            ASSERT(format(x) == "[3, 3, 2, 1]");
+            x.insert(x.begin() + 1, 2, 4);
+            ASSERT(format(x) == "[3, 4, 4, 3, 2, 1]");
+            x.insert(x.begin(), y.begin(), y.end());
+            ASSERT(format(x) == "[0, 1, 2, 3, 4, 4, 3, 2, 1]");
+            x.insert(x.end() - 1, { 7 });
+            ASSERT(format(x) == "[0, 1, 2, 3, 4, 4, 3, 2, 7, 1]");
+
+            x.erase(x.begin() + 1);
+            ASSERT(format(x) == "[0, 2, 3, 4, 4, 3, 2, 7, 1]");
+            x.erase(x.end() - 2);
+            ASSERT(format(x) == "[0, 2, 3, 4, 4, 3, 2, 1]");
+            x.erase(x.begin() + 1, x.begin() + 3);
+            ASSERT(format(x) == "[0, 4, 4, 3, 2, 1]");
+            x.erase(x.begin() + 3, x.end() - 1);
+            ASSERT(format(x) == "[0, 4, 4, 1]");
+
+            plastic::SegmentedDeque<int> big;
+            const int& anchor{ big.emplace_back(0) };
+            for (int i{ 1 }; i != 10'000; ++i) {
+                big.push_back(i);
+                big.push_front(-i);
+            }
+            ASSERT(anchor == 0);
+            ASSERT(std::addressof(anchor) == std::addressof(big[9'999]));
+            ASSERT(big.end() - big.begin() == 19'999);
+            ASSERT(std::ranges::is_sorted(big));
+            ASSERT(big.begin() + 12'345 - 345 == big.begin() + 12'000);
+            ASSERT(big.end()[-1] == 9'999);
+
+            for (int i{}; i != 100'000; ++i) {
+                big.push_back(big.front());
+                big.pop_front();
+            }
+            ASSERT(big.size() == 19'999);
+            ASSERT(big.front() == -9'999 + 100'000 % 19'999);
+
+            x = { 3, 2, 1 };
+            y = { 0, 1 };
+            x.swap(y);
+            ASSERT(format(x) == "[0, 1]");
+            ASSERT(format(y) == "[3, 2, 1]");
+
+            x.clear();
+            ASSERT(format(x) == "[]");
+
+            x = { 1, 2 };
+            y = { 1, 2, 3 };
+            ASSERT(x == x);
+            ASSERT(x != y);
+            ASSERT(x < y);
+            ASSERT(y >= x);
+        }
+
         TEST_METHOD(list) {
             std::array arr{ 5, 4, 3, 2, 1 };
 
@@ -373,6 +750,20 @@ namespace tests {
             x.pop_back();
             ASSERT(format(x) == "[3, 2, 1, 5]");
 
+            x = { 3, 2, 1 };
+            ASSERT(x.emplace_back(x.front()) == 3);
+            ASSERT(x.emplace_front(x.back()) == 3);
+            ASSERT(format(x) == "[3, 3, 2, 1, 3]");
+            ASSERT(*x.emplace(std::ranges::next(x.begin(), 1), 4) == 4);
+            ASSERT(format(x) == "[3, 4, 3, 2, 1, 3]");
+
+            plastic::List<std::unique_ptr<int>> p;
+            p.push_back(std::make_unique<int>(1));
+            p.push_front(std::make_unique<int>(0));
+            p.emplace_back(new int{ 3 });
+            p.insert(std::ranges::prev(p.end()), std::make_unique<int>(2));
+            ASSERT(*p.front() == 0 && **std::ranges::next(p.begin(), 2) == 2 && *p.back() == 3);
+
             x = { 3, 2, 1 };
             y = { 0, 1, 2 };
             x.insert(std::ranges::next(x.begin(), 1), 3);
@@ -403,6 +794,52 @@ namespace tests {
             x.clear();
             ASSERT(format(x) == "[]");
 
+            x = { 1, 2, 3 };
+            y = { 4, 5, 6 };
+            const int* moved{ &y.front() };
+            x.splice(std::ranges::next(x.begin(), 1), y, y.begin());
+            ASSERT(format(x) == "[1, 4, 2, 3]");
+            ASSERT(format(y) == "[5, 6]");
+            ASSERT(&*std::ranges::next(x.begin(), 1) == moved);
+            x.splice(x.end(), y);
+            ASSERT(format(x) == "[1, 4, 2, 3, 5, 6]");
+            ASSERT(y.empty());
+            x.splice(x.begin(), x, std::ranges::next(x.begin(), 2), x.end());
+            ASSERT(format(x) == "[2, 3, 5, 6, 1, 4]");
+            y = { 7 };
+            y.splice(y.begin(), x, std::ranges::next(x.begin(), 1), std::ranges::next(x.begin(), 3));
+            ASSERT(format(y) == "[3, 5, 7]");
+            ASSERT(x.size() == 4 && y.size() == 3);
+            x.clear();
+            y.push_back(8);
+            ASSERT(format(y) == "[3, 5, 7, 8]");
+
+            x = { 3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5 };
+            x.sort();
+            ASSERT(format(x) == "[1, 1, 2, 3, 3, 4, 5, 5, 5, 6, 9]");
+            ASSERT(format(x.rbegin(), x.rend()) == "[9, 6, 5, 5, 5, 4, 3, 3, 2, 1, 1]");
+            x.sort(std::greater{});
+            ASSERT(format(x) == "[9, 6, 5, 5, 5, 4, 3, 3, 2, 1, 1]");
+            ASSERT(x.unique() == 4);
+            ASSERT(format(x) == "[9, 6, 5, 4, 3, 2, 1]");
+            x.reverse();
+            ASSERT(format(x) == "[1, 2, 3, 4, 5, 6, 9]");
+            y = { 0, 2, 7, 10 };
+            x.merge(y);
+            ASSERT(format(x) == "[0, 1, 2, 2, 3, 4, 5, 6, 7, 9, 10]");
+            ASSERT(format(x.rbegin(), x.rend()) == "[10, 9, 7, 6, 5, 4, 3, 2, 2, 1, 0]");
+            ASSERT(y.empty());
+            ASSERT(x.remove(2) == 2);
+            ASSERT(x.remove_if([](int i) { return i % 3 == 0; }) == 4);
+            ASSERT(format(x) == "[1, 4, 5, 7, 10]");
+            x = { 3, 1, 3, 2, 3 };
+            ASSERT(x.remove(x.front()) == 3);
+            ASSERT(format(x) == "[1, 2]");
+
+            plastic::List<std::pair<int, int>> s{ { 2, 0 }, { 1, 1 }, { 2, 2 }, { 1, 3 }, { 0, 4 } };
+            s.sort([](auto& i, auto& j) { return i.first < j.first; });
+            ASSERT(std::ranges::equal(s | std::views::values, std::array{ 4, 1, 3, 0, 2 }));
+
             x = { 1, 2 };
             y = { 1, 2, 3 };
             ASSERT(x == x);
@@ -412,6 +849,63 @@ namespace tests {
             ASSERT(x <= y);
             ASSERT(y >= x);
         }
+
+        TEST_METHOD(hive) {
+            plastic::Hive<int> h1;
+            ASSERT(format(h1) == "[]");
+            plastic::Hive h2(3, 4);
+            ASSERT(format(h2) == "[4, 4, 4]");
+            plastic::Hive h3{ 1, 2, 3 };
+            ASSERT(format(h3) == "[1, 2, 3]");
+            plastic::Hive h4(h3);
+            ASSERT(format(h4) == "[1, 2, 3]");
+            plastic::Hive h5(std::move(h4));
+            ASSERT(format(h5) == "[1, 2, 3]");
+            ASSERT(h4.empty());
+
+            plastic::Hive<int> h;
+            std::vector<int*> ptrs;
+            for (int i{}; i != 100; ++i) {
+                ptrs.push_back(&*h.insert(i));
+            }
+            ASSERT(h.size() == 100);
+            ASSERT(h.capacity() >= 100);
+            for (auto i{ h.begin() }; i != h.end();) {
+                i = *i % 3 == 0 ? h.erase(i) : std::next(i);
+            }
+            ASSERT(h.size() == 66);
+            for (int i{}; i != 100; ++i) {
+                ASSERT(i % 3 == 0 || *ptrs[i] == i);
+            }
+            ASSERT(std::ranges::none_of(h, [](int i) { return i % 3 == 0; }));
+            ASSERT(std::ranges::equal(h | std::views::reverse, std::views::iota(0, 100) | std::views::filter([](int i) { return i % 3 != 0; }) | std::views::reverse));
+
+            std::size_t capacity{ h.capacity() };
+            for (int i{}; i != 34; ++i) {
+                h.emplace(-1);
+            }
+            ASSERT(h.capacity() == capacity);
+            ASSERT(std::ranges::count(h, -1) == 34);
+            ASSERT(*ptrs[1] == 1 && *ptrs[98] == 98);
+
+            ASSERT(h.get_iterator(ptrs[50]) != h.end());
+            h.erase(h.get_iterator(ptrs[50]));
+            ASSERT(std::ranges::find(h, 50) == h.end());
+
+            h.erase(h.begin(), h.end());
+            ASSERT(h.empty());
+            ASSERT(h.memory_stats().allocations == 0);
+            h.insert({ 1, 2 });
+            ASSERT(format(h) == "[1, 2]");
+
+            plastic::Hive<std::string> s{ "a", "b", "c", "d" };
+            s.erase(std::next(s.begin()));
+            s.erase(std::next(s.begin()));
+            s.insert("e");
+            ASSERT(std::ranges::equal(s, std::array{ "a", "e", "d" }));
+            s.clear();
+            ASSERT(s.empty() && s.begin() == s.end());
+        }
     };
 
 }
@@ -83,6 +83,9 @@ namespace tests {
         ASSERT(tests::format(x) == "[0, 1, 2, 2, 2, 2, 3, 4]");
         x.insert({ 5, 3, 1, 0, 2 });
         ASSERT(tests::format(x) == "[0, 0, 1, 1, 2, 2, 2, 2, 2, 3, 3, 4, 5]");
+        ASSERT(*x.emplace(6) == 6);
+        ASSERT(tests::format(x) == "[0, 0, 1, 1, 2, 2, 2, 2, 2, 3, 3, 4, 5, 6]");
+        x.erase(6);
 
         x.erase(2);
         ASSERT(tests::format(x) == "[0, 0, 1, 1, 3, 3, 4, 5]");
@@ -102,6 +105,29 @@ namespace tests {
         ASSERT(tests::format(x) == "[0, 0, 0, 0, 1, 2, 3, 3, 4, 5]");
         ASSERT(tests::format(c) == "[]");
 
+        std::array sorted{ 1, 2, 2, 3, 5, 8 };
+        Tr g(plastic::from_sorted, sorted.begin(), sorted.end());
+        ASSERT(tests::format(g) == "[1, 2, 2, 3, 5, 8]");
+        g.insert(plastic::from_sorted, sorted.begin(), sorted.begin() + 3);
+        ASSERT(tests::format(g) == "[1, 1, 2, 2, 2, 2, 3, 5, 8]");
+        Tr h{ 9, 0, 4 };
+        g.merge(h);
+        ASSERT(tests::format(g) == "[0, 1, 1, 2, 2, 2, 2, 3, 4, 5, 8, 9]");
+        ASSERT(h.empty());
+        h.insert(7);
+        g.merge(h);
+        ASSERT(tests::format(g) == "[0, 1, 1, 2, 2, 2, 2, 3, 4, 5, 7, 8, 9]");
+
+        Tr m;
+        for (int i{}; i != 10; ++i) {
+            m.insert(m.end(), i / 2);
+        }
+        ASSERT(tests::format(m) == "[0, 0, 1, 1, 2, 2, 3, 3, 4, 4]");
+        ASSERT(*m.insert(m.begin(), -1) == -1);
+        ASSERT(std::ranges::distance(m.begin(), m.emplace_hint(m.find(3), 3)) == 7);
+        ASSERT(*m.insert(m.find(4), 10) == 10);
+        ASSERT(tests::format(m) == "[-1, 0, 0, 1, 1, 2, 2, 3, 3, 3, 4, 4, 10]");
+
         Tr d{ 1, 2 }, e{ 1, 2, 2 }, f{ 1, 2, 3 };
         ASSERT(d == d);
         ASSERT(d != e);
@@ -112,18 +138,549 @@ namespace tests {
         ASSERT(f >= d);
     }
 
+    // counts comparisons, which is the depth a lookup reaches
+    struct CountingLess {
+        inline static std::size_t count{};
+
+        bool operator()(int left, int right) const {
+            ++count;
+            return left < right;
+        }
+    };
+
+    // average comparisons and nanoseconds per successful lookup, after inserting one element at a time
+    template <template <class, class, class> class Tr>
+    std::pair<double, double> benchmark_lookups(const std::vector<int>& inserted, const std::vector<int>& looked_up) {
+        Tr<int, CountingLess, void> tree;
+        for (int i : inserted) {
+            tree.insert(i);
+        }
+        CountingLess::count = 0;
+
+        std::size_t found{};
+        auto start{ std::chrono::steady_clock::now() };
+        for (int i : looked_up) {
+            found += tree.contains(i);
+        }
+        std::chrono::duration<double, std::nano> time{ std::chrono::steady_clock::now() - start };
+
+        ASSERT(found == looked_up.size());
+        return { static_cast<double>(CountingLess::count) / found, time.count() / found };
+    }
+
+    // the last digits of the values in order, a monoid that does not commute
+    struct Digits {
+        using value_type = std::string;
+
+        std::string identity() const {
+            return {};
+        }
+
+        std::string lift(int value) const {
+            return std::to_string(value % 10);
+        }
+
+        std::string combine(const std::string& left, const std::string& right) const {
+            return left + right;
+        }
+    };
+
+    template <template <class, class, class> class Tr>
+    void test_order_statistics() {
+        Tr<int, std::less<int>, plastic::OrderStatistics<>> t;
+        for (int i{}; i != 1000; ++i) {
+            t.insert(i * 7919 % 1000 / 2);
+        }
+        ASSERT(t.count(250) == 2 && t.count(500) == 0);
+        ASSERT(t.rank(250) == 500 && t.rank(-1) == 0);
+        ASSERT(*t.nth(501) == 250 && t.nth(1000) == t.end());
+        ASSERT(t.rank(t.end()) == 1000);
+
+        for (int i{}; i < 500; i += 3) {
+            t.erase(i);
+        }
+        ASSERT(t.size() == 666);
+        auto u{ t };
+        u.insert(plastic::from_sorted, t.begin(), t.end());
+        for (auto* tree : { &t, &u }) {
+            std::size_t index{};
+            for (auto i{ tree->begin() }; i != tree->end(); ++i, ++index) {
+                ASSERT(tree->nth(index) == i && tree->rank(i) == index);
+            }
+        }
+        ASSERT(u.count(1) == 4);
+
+        Tr<int, std::less<int>, plastic::OrderStatistics<Digits>> s;
+        ASSERT(s.aggregate().empty());
+        std::vector<int> values(300);
+        std::iota(values.begin(), values.end(), 0);
+        std::ranges::shuffle(values, std::mt19937{});
+        for (int i : values) {
+            s.insert(i);
+        }
+        for (int i{}; i < 300; i += 7) {
+            s.erase(values[i]);
+        }
+
+        std::string digits;
+        for (int i : s) {
+            digits += std::to_string(i % 10);
+        }
+        ASSERT(s.aggregate() == digits);
+        std::mt19937 random;
+        for (int i{}; i != 100; ++i) {
+            std::size_t first{ random() % (s.size() + 1) }, last{ random() % (s.size() + 1) };
+            if (first > last) {
+                std::ranges::swap(first, last);
+            }
+            ASSERT(s.aggregate(s.nth(first), s.nth(last)) == digits.substr(first, last - first));
+        }
+    }
+
+    struct Record {
+        int id;
+        std::string name;
+    };
+
+    // compares records with bare ids, from which no record can be built
+    struct ById {
+        using is_transparent = void;
+
+        bool operator()(const Record& left, const Record& right) const {
+            return left.id < right.id;
+        }
+
+        bool operator()(const Record& left, int right) const {
+            return left.id < right;
+        }
+
+        bool operator()(int left, const Record& right) const {
+            return left < right.id;
+        }
+    };
+
+    template <class Records, class Strings>
+    void test_transparent_lookup() {
+        Records t;
+        for (int i{}; i != 100; ++i) {
+            t.insert({ i / 2, std::to_string(i) });
+        }
+        ASSERT(t.find(10)->name == "20" && t.find(100) == t.end());
+        ASSERT(t.contains(0) && !t.contains(-1));
+        ASSERT(t.count(7) == 2 && t.count(50) == 0);
+        ASSERT(t.lower_bound(7)->name == "14" && t.upper_bound(7)->name == "16");
+        auto [first, last]{ t.equal_range(49) };
+        ASSERT(first->name == "98" && std::ranges::distance(first, last) == 2);
+        ASSERT(t.erase(3) == 2 && t.size() == 98 && !t.contains(3));
+
+        Strings s{ "apple", "banana", "cherry" };
+        std::string_view probe{ "banana split" };
+        ASSERT(s.find(probe.substr(0, 6)) == ++s.begin());
+        ASSERT(s.contains("cherry") && s.lower_bound(probe) == --s.end());
+        ASSERT(s.erase("apple") == 1 && s.size() == 2);
+    }
+
     TEST_CLASS(tree) {
     public:
         TEST_METHOD(red_black_tree) {
             test_search_tree<plastic::RedBlackTree<int>>();
         }
 
-        BEGIN_TEST_METHOD_ATTRIBUTE(avl_tree)
-            TEST_IGNORE()
-        END_TEST_METHOD_ATTRIBUTE()
-
         TEST_METHOD(avl_tree) {
             test_search_tree<plastic::AvlTree<int>>();
+
+            plastic::AvlTree<int> t;
+            for (int i{}; i != 1000; ++i) {
+                t.insert(i);
+            }
+            for (int i{}; i < 1000; i += 3) {
+                t.erase(i);
+            }
+            ASSERT(t.size() == 666);
+            ASSERT(std::ranges::none_of(t, [](int i) { return i % 3 == 0; }));
+        }
+
+        TEST_METHOD(bulk_build) {
+            constexpr int count{ 1 << 16 };
+            std::vector<int> evens(count / 2), odds(count / 2);
+            for (int i{}; i != count / 2; ++i) {
+                evens[i] = i * 2;
+                odds[i] = i * 2 + 1;
+            }
+
+            plastic::RedBlackTree<int, CountingLess> r(plastic::from_sorted, evens.begin(), evens.end()), s(odds.begin(), odds.end());
+            plastic::AvlTree<int, CountingLess> a(plastic::from_sorted, evens.begin(), evens.end()), b(odds.begin(), odds.end());
+            r.merge(s);
+            a.merge(b);
+            ASSERT(s.empty() && b.empty());
+            ASSERT(std::ranges::equal(r, std::views::iota(0, count)));
+            ASSERT(std::ranges::equal(a, std::views::iota(0, count)));
+
+            // both are rebuilt with minimal height
+            CountingLess::count = 0;
+            for (int i{}; i != count; ++i) {
+                ASSERT(r.contains(i) && a.contains(i));
+            }
+            ASSERT(CountingLess::count <= 2 * count * (std::bit_width(static_cast<unsigned>(count)) + 1));
+
+            // after a merge the trees share their chunks, so cleared nodes must be reused by the other tree
+            plastic::RedBlackTree<std::string> x, y;
+            std::size_t bytes{};
+            for (int round{}; round != 50; ++round) {
+                for (int i{}; i != 100; ++i) {
+                    y.insert(std::to_string(i));
+                }
+                x.merge(y);
+                x.clear();
+                if (round == 0) {
+                    bytes = x.memory_stats().bytes_allocated;
+                }
+            }
+            ASSERT(x.memory_stats().bytes_allocated == bytes);
+        }
+
+        TEST_METHOD(hinted_insertion) {
+            constexpr int count{ 1 << 12 };
+            plastic::RedBlackTree<int, CountingLess> r;
+            plastic::AvlTree<int, CountingLess> a;
+            CountingLess::count = 0;
+            for (int i{}; i != count; ++i) {
+                r.insert(r.end(), i);
+                a.emplace_hint(a.end(), i);
+            }
+            ASSERT(CountingLess::count <= 2 * 2 * count);
+            ASSERT(std::ranges::equal(r, std::views::iota(0, count)));
+            ASSERT(std::ranges::equal(a, std::views::iota(0, count)));
+
+            CountingLess::count = 0;
+            for (int i{}; i != count; ++i) {
+                ASSERT(r.contains(i) && a.contains(i));
+            }
+            ASSERT(CountingLess::count <= 2 * count * (2 * std::bit_width(static_cast<unsigned>(count)) + 1));
+
+            // the value of a node whose insertion throws is destroyed
+            auto value{ std::make_shared<int>(1) };
+            auto throwing{ [](const std::shared_ptr<int>& left, const std::shared_ptr<int>& right) {
+                if (*left == *right) {
+                    throw std::invalid_argument{ "equivalent values" };
+                }
+                return *left < *right;
+            } };
+            plastic::RedBlackTree<std::shared_ptr<int>, decltype(throwing)> t{ std::make_shared<int>(1) };
+            for (auto insert : { 0, 1 }) {
+                try {
+                    insert == 0 ? t.insert(value) : t.emplace_hint(t.end(), value);
+                    ASSERT(false);
+                }
+                catch (const std::invalid_argument&) {}
+            }
+            ASSERT(value.use_count() == 1 && t.size() == 1);
+
+            // and a handle whose insertion throws gets its element back
+            decltype(t) u{ value };
+            auto node{ u.extract(u.begin()) };
+            try {
+                t.insert(std::move(node));
+                ASSERT(false);
+            }
+            catch (const std::invalid_argument&) {}
+            ASSERT(!node.empty() && node.value() == value && value.use_count() == 2 && t.size() == 1);
+        }
+
+        TEST_METHOD(b_tree) {
+            test_search_tree<plastic::BTree<int>>();
+            test_search_tree<plastic::BTree<int, std::less<int>, 3>>();
+
+            // small nodes split and merge at every level
+            plastic::BTree<std::string, std::less<std::string>, 4> t;
+            std::multiset<std::string> expected;
+            std::mt19937 random;
+            for (int i{}; i != 5000; ++i) {
+                auto value{ std::to_string(random() % 1000) };
+                if (random() % 3 != 0) {
+                    t.insert(value);
+                    expected.insert(value);
+                }
+                else {
+                    ASSERT(t.erase(value) == expected.erase(value));
+                }
+            }
+            ASSERT(std::ranges::equal(t, expected));
+            ASSERT(std::ranges::equal(t | std::views::reverse, expected | std::views::reverse));
+            for (int i{}; i != 1000; ++i) {
+                auto value{ std::to_string(i) };
+                ASSERT(t.count(value) == expected.count(value));
+                ASSERT(*t.lower_bound(value) == *expected.lower_bound(value));
+            }
+
+            auto u{ t };
+            ASSERT(u == t);
+            for (auto i{ u.begin() }; i != u.end();) {
+                i = u.erase(i);
+            }
+            ASSERT(u.empty());
+            for (int i{}; i != 1000; ++i) {
+                u.insert(u.end(), std::to_string(i / 10));
+            }
+            ASSERT(std::ranges::is_sorted(u) && u.size() == 1000);
+
+            constexpr int count{ 1 << 16 };
+            auto values{ std::views::iota(0, count) };
+            plastic::BTree<int> b(plastic::from_sorted, values.begin(), values.end());
+            plastic::RedBlackTree<int> r(plastic::from_sorted, values.begin(), values.end());
+            ASSERT(std::ranges::equal(b, values));
+            ASSERT(b.memory_stats().bytes_per_element() * 4 < r.memory_stats().bytes_per_element());
+
+            plastic::BTree<int> odds;
+            for (int i{ 1 }; i < count; i += 2) {
+                b.erase(i);
+                odds.insert(i);
+            }
+            ASSERT(b.size() == count / 2 && *b.upper_bound(100) == 102);
+            b.merge(odds);
+            ASSERT(odds.empty() && std::ranges::equal(b, values));
+
+            // splits reuse the nodes freed by merges
+            plastic::BTree<int, std::less<int>, 4> churned(plastic::from_sorted, values.begin(), values.begin() + 2000);
+            std::size_t bytes{};
+            for (int round{}; round != 100; ++round) {
+                int first{ round * 300 % 1500 };
+                for (int i{ first }; i != first + 500; ++i) {
+                    churned.erase(i);
+                }
+                for (int i{ first }; i != first + 500; ++i) {
+                    churned.insert(i);
+                }
+                if (round == 10) {
+                    bytes = churned.memory_stats().bytes_allocated;
+                }
+            }
+            ASSERT(churned.memory_stats().bytes_allocated == bytes && std::ranges::equal(churned, std::views::iota(0, 2000)));
+        }
+
+        TEST_METHOD(order_statistics) {
+            test_order_statistics<plastic::RedBlackTree>();
+            test_order_statistics<plastic::AvlTree>();
+        }
+
+        TEST_METHOD(transparent_lookup) {
+            test_transparent_lookup<plastic::RedBlackTree<Record, ById>, plastic::RedBlackTree<std::string, std::less<>>>();
+            test_transparent_lookup<plastic::AvlTree<Record, ById>, plastic::AvlTree<std::string, std::less<>>>();
+            test_transparent_lookup<plastic::BTree<Record, ById, 4>, plastic::BTree<std::string, std::less<>>>();
+        }
+
+        TEST_METHOD(node_handles) {
+            plastic::RedBlackTree<std::string> active{ "a", "b", "c", "d" }, expired;
+            const std::string* address{ &*active.find("b") };
+            auto node{ active.extract("b") };
+            ASSERT(!node.empty() && &node.value() == address);
+            ASSERT(std::ranges::equal(active, std::array{ "a", "c", "d" }));
+            // the element moves into a node of the other tree, which then has chunks of its own
+            ASSERT(*expired.insert(std::move(node)) == "b" && expired.memory_stats().allocations == 3);
+            ASSERT(node.empty() && expired.size() == 1 && expired.front() == "b");
+
+            // the key may change while the node is out of the tree
+            node = expired.extract(expired.begin());
+            node.value() = "e";
+            ASSERT(*active.insert(active.end(), std::move(node)) == "e");
+            ASSERT(std::ranges::equal(active, std::array{ "a", "c", "d", "e" }) && expired.empty());
+            ASSERT(!active.extract("z") && active.insert(plastic::RedBlackTree<std::string>::node_type{}) == active.end());
+
+            // a handle keeps the chunks of its tree alive
+            plastic::AvlTree<std::string, std::less<>, plastic::OrderStatistics<>> numbers;
+            for (int i{}; i != 100; ++i) {
+                numbers.insert(std::to_string(i));
+            }
+            auto kept{ numbers.extract(std::string_view{ "42" }) };
+            auto dropped{ numbers.extract(numbers.nth(10)) };
+            ASSERT(numbers.size() == 98 && numbers.rank("42") == 36);
+            numbers = {};
+            ASSERT(kept.value() == "42" && dropped.value() == "18");
+            kept.value() = "0";
+            plastic::AvlTree<std::string, std::less<>, plastic::OrderStatistics<>> zeros{ "0", "0" };
+            auto inserted{ zeros.insert(zeros.begin(), std::move(kept)) };
+            ASSERT(inserted == zeros.begin() && zeros.rank(zeros.end()) == 3);
+
+            // expiring elements and clearing them again reuses the nodes
+            std::size_t bytes{};
+            for (int round{}; round != 50; ++round) {
+                for (int i{}; i != 10; ++i) {
+                    active.insert(std::to_string(i));
+                    expired.insert(active.extract(std::to_string(i)));
+                }
+                expired.clear();
+                if (round == 0) {
+                    bytes = active.memory_stats().bytes_allocated;
+                }
+            }
+            ASSERT(active.memory_stats().bytes_allocated == bytes && expired.empty());
+        }
+
+        TEST_METHOD(join_and_split) {
+            plastic::RedBlackTree<int> a{ 1, 2, 3 }, b{ 5, 6 };
+            auto c{ join(std::move(a), 4, std::move(b)) };
+            ASSERT(format(c) == "[1, 2, 3, 4, 5, 6]");
+            ASSERT(a.empty() && b.empty() && c.size() == 6);
+            auto d{ c.split(3) };
+            ASSERT(format(c) == "[1, 2]" && format(d) == "[3, 4, 5, 6]");
+            c.insert(0);
+            d.erase(5);
+            d.insert(7);
+            ASSERT(format(c) == "[0, 1, 2]" && format(d) == "[3, 4, 6, 7]");
+            ASSERT(c.split(10).empty() && d.split(0).size() == 4 && d.empty());
+
+            // trees of very different heights, whose sizes are kept by the order statistics
+            plastic::RedBlackTree<int, std::less<int>, plastic::OrderStatistics<>> small{ -1 }, large;
+            for (int i{ 1 }; i != 5000; ++i) {
+                large.insert(i);
+            }
+            auto joined{ join(std::move(small), 0, std::move(large)) };
+            ASSERT(std::ranges::equal(joined, std::views::iota(-1, 5000)));
+            ASSERT(*joined.nth(1) == 0 && joined.rank(4000) == 4001);
+            for (int i{}; i < 5000; i += 7) {
+                auto rest{ joined.split(i) };
+                ASSERT(joined.size() == static_cast<std::size_t>(i + 1) && rest.size() == static_cast<std::size_t>(5000 - i));
+                ASSERT(*rest.nth(0) == i && joined.back() == i - 1);
+                int pivot{ rest.front() };
+                rest.erase(rest.begin());
+                joined = join(std::move(joined), pivot, std::move(rest));
+            }
+            ASSERT(std::ranges::equal(joined, std::views::iota(-1, 5000)));
+
+            // the smaller part moves into a pool of its own, so the two may change on different threads
+            plastic::RedBlackTree<std::string> words{ "a", "b", "c", "d", "e" };
+            auto tail{ words.split("b") };
+            ASSERT(words.size() == 1 && words.front() == "a" && tail.size() == 4 && tail.front() == "b");
+            words.clear();
+            tail.insert("f");
+            ASSERT(std::ranges::equal(tail, std::vector<std::string>{ "b", "c", "d", "e", "f" }));
+            ASSERT(words.memory_stats().allocations == 1);
+
+            auto upper{ joined.split(2500) };
+            {
+                std::jthread lower_worker{ [&] {
+                    for (int i{}; i != 20'000; ++i) {
+                        joined.erase(i % 2500);
+                        joined.insert(i % 2500);
+                    }
+                } };
+                for (int i{}; i != 20'000; ++i) {
+                    upper.erase(2500 + i % 2500);
+                    upper.insert(2500 + i % 2500);
+                }
+            }
+            ASSERT(std::ranges::equal(joined, std::views::iota(-1, 2500)));
+            ASSERT(std::ranges::equal(upper, std::views::iota(2500, 5000)));
+        }
+
+        TEST_METHOD(set_operations) {
+            // large enough to be processed on several threads
+            constexpr int count{ 1 << 17 };
+            std::mt19937 random;
+            std::vector<int> x(count), y(count / 16);
+            std::ranges::generate(x, [&]() { return static_cast<int>(random() % (count * 2)); });
+            std::ranges::generate(y, [&]() { return static_cast<int>(random() % (count * 2)); });
+            std::ranges::sort(x);
+            std::ranges::sort(y);
+
+            plastic::RedBlackTree<int> p(x.begin(), x.end()), q(y.begin(), y.end());
+            auto in_y{ [&](int i) { return std::ranges::binary_search(y, i); } };
+            auto r{ p }, s{ p }, t{ q };
+            r.intersect(q);
+            ASSERT(std::ranges::equal(r, x | std::views::filter(in_y)));
+            ASSERT(r.size() == static_cast<std::size_t>(std::ranges::count_if(x, in_y)));
+            s.subtract(q);
+            ASSERT(std::ranges::equal(s, x | std::views::filter(std::not_fn(in_y))));
+            ASSERT(s.size() + r.size() == x.size());
+
+            std::vector<int> both;
+            std::ranges::merge(x, y, std::back_inserter(both));
+            t.unite(p);
+            ASSERT(p.empty() && std::ranges::equal(t, both) && t.size() == both.size());
+            ASSERT(p.memory_stats().allocations == 1);
+            t.subtract(t);
+            ASSERT(t.empty());
+
+            // equivalent elements of the other tree follow
+            using Pair = std::pair<int, int>;
+            auto by_first{ [](const Pair& left, const Pair& right) { return left.first < right.first; } };
+            plastic::RedBlackTree<Pair, decltype(by_first)> u, v;
+            for (int i{}; i != 1000; ++i) {
+                u.insert({ i % 10, 0 });
+                v.insert({ i % 20, 1 });
+            }
+            u.unite(v);
+            ASSERT(u.size() == 2000 && std::ranges::is_sorted(u));
+            u.subtract(plastic::RedBlackTree<Pair, decltype(by_first)>{ { 3, 2 } });
+            ASSERT(u.size() == 1850 && !u.contains({ 3, 0 }));
+        }
+
+        TEST_METHOD(flat_set) {
+            plastic::FlatSet<int> s{ 5, 3, 5, 1, 3 };
+            ASSERT(format(s) == "[1, 3, 5]");
+            auto [pos, inserted]{ s.insert(4) };
+            ASSERT(inserted && *pos == 4 && pos == s.begin() + 2);
+            ASSERT(!s.insert(3).second && s.size() == 4);
+            s.insert({ 9, 0, 4, 7, 0 });
+            ASSERT(format(s) == "[0, 1, 3, 4, 5, 7, 9]");
+            std::array sorted{ 2, 6, 7, 8 };
+            s.insert(plastic::from_sorted, sorted.begin(), sorted.end());
+            ASSERT(format(s) == "[0, 1, 2, 3, 4, 5, 6, 7, 8, 9]");
+            ASSERT(s.erase(4) == 1 && s.erase(4) == 0);
+            ASSERT(*s.erase(s.begin()) == 1 && s.front() == 1 && s.back() == 9);
+
+            // frozen lookups agree with the binary search for every shape of the last level
+            std::mt19937 random;
+            for (int size{}; size != 70; ++size) {
+                std::vector<int> values(size);
+                std::ranges::generate(values, [&]() { return static_cast<int>(random() % 100) * 2; });
+                plastic::FlatSet<int> t(values.begin(), values.end()), u{ t };
+                std::set<int> expected(values.begin(), values.end());
+                ASSERT(std::ranges::equal(t, expected));
+                u.freeze();
+                ASSERT(u.frozen() == (size != 0) && u == t);
+                for (int i{ -1 }; i <= 200; ++i) {
+                    ASSERT(u.lower_bound(i) - u.begin() == t.lower_bound(i) - t.begin());
+                    ASSERT(u.upper_bound(i) - u.begin() == t.upper_bound(i) - t.begin());
+                    ASSERT(u.contains(i) == expected.contains(i));
+                }
+            }
+
+            s.freeze();
+            ASSERT(*s.find(5) == 5 && s.find(4) == s.end());
+            s.insert(5);
+            ASSERT(s.frozen());
+            s.insert(4);
+            ASSERT(!s.frozen() && s.contains(4));
+
+            plastic::FlatSet<std::string, std::less<>> strings{ "cherry", "apple", "banana" };
+            strings.freeze();
+            std::string_view probe{ "banana split" };
+            ASSERT(strings.find(probe.substr(0, 6)) == strings.begin() + 1);
+            ASSERT(strings.lower_bound(probe) == strings.end() - 1 && strings.count("apple") == 1);
+            ASSERT(strings.erase("apple") == 1 && !strings.frozen() && strings.size() == 2);
+        }
+
+        TEST_METHOD(lookup_benchmark) {
+            constexpr int count{ 1 << 16 };
+            std::vector<int> sorted(count);
+            std::iota(sorted.begin(), sorted.end(), 0);
+            std::vector<int> shuffled{ sorted };
+            std::ranges::shuffle(shuffled, std::mt19937{});
+
+            for (auto& [name, keys] : { std::pair{ "sorted", sorted }, std::pair{ "shuffled", shuffled } }) {
+                auto [avl_depth, avl_time]{ benchmark_lookups<plastic::AvlTree>(keys, shuffled) };
+                auto [red_black_depth, red_black_time]{ benchmark_lookups<plastic::RedBlackTree>(keys, shuffled) };
+                Microsoft::VisualStudio::CppUnitTestFramework::Logger::WriteMessage(std::format(
+                    "{} insertions: avl {:.2f} comparisons {:.1f} ns, red-black {:.2f} comparisons {:.1f} ns",
+                    name, avl_depth, avl_time, red_black_depth, red_black_time
+                ).c_str());
+
+                // lookups take a comparison per level plus one to confirm the match
+                ASSERT(avl_depth <= 1.45 * std::log2(count) + 1);
+                ASSERT(red_black_depth <= 2 * std::log2(count) + 1);
+            }
+            ASSERT(benchmark_lookups<plastic::AvlTree>(sorted, sorted).first < benchmark_lookups<plastic::RedBlackTree>(sorted, sorted).first);
         }
     };
 